@@ -1,186 +1,77 @@
-#include "actions.h"
-
-/**
- * intialize_actions_array -
- * Initializes an array of Action structures with predefined values.
- *
- * @param actions A pointer to the array of Action structures to be initialized.
- */
-void intialize_actions_array(Action* actions)
-{
-	actions[0].action_name = "mov";
-	actions[0].action_code = 0;
-	actions[0].source_operands = "0,1,2,3";
-	actions[0].destination_operands = "1,2,3";
-
-	actions[1].action_name = "cmp";
-	actions[1].action_code = 1;
-	actions[1].source_operands = "0,1,2,3";
-	actions[1].destination_operands = "0,1,2,3";
-
-	actions[2].action_name = "add";
-	actions[2].action_code = 2;
-	actions[2].source_operands = "0,1,2,3";
-	actions[2].destination_operands = "1,2,3";
-
-	actions[3].action_name = "sub";
-	actions[3].action_code = 3;
-	actions[3].source_operands = "0,1,2,3";
-	actions[3].destination_operands = "1,2,3";
-
-	actions[4].action_name = "lea";
-	actions[4].action_code = 4;
-	actions[4].source_operands = "1";
-	actions[4].destination_operands = "1,2,3";
-
-	actions[5].action_name = "clr";
-	actions[5].action_code = 5;
-	actions[5].source_operands = "-1";
-	actions[5].destination_operands = "1,2,3";
-
-	actions[6].action_name = "not";
-	actions[6].action_code = 6;
-	actions[6].source_operands = "-1";
-	actions[6].destination_operands = "1,2,3";
 
-	actions[7].action_name = "inc";
-	actions[7].action_code = 7;
-	actions[7].source_operands = "-1";
-	actions[7].destination_operands = "1,2,3";
-
-	actions[8].action_name = "dec";
-	actions[8].action_code = 8;
-	actions[8].source_operands = "-1";
-	actions[8].destination_operands = "1,2,3";
-
-	actions[9].action_name = "jmp";
-	actions[9].action_code = 9;
-	actions[9].source_operands = "-1";
-	actions[9].destination_operands = "1,2,3";
-
-	actions[10].action_name = "bne";
-	actions[10].action_code = 10;
-	actions[10].source_operands = "-1";
-	actions[10].destination_operands = "1,2";
-
-	actions[11].action_name = "red";
-	actions[11].action_code = 11;
-	actions[11].source_operands = "-1";
-	actions[11].destination_operands = "1,2";
-
-	actions[12].action_name = "prn";
-	actions[12].action_code = 12;
-	actions[12].source_operands = "-1";
-	actions[12].destination_operands = "1,2,3";
-
-	actions[13].action_name = "jsr";
-	actions[13].action_code = 13;
-	actions[13].source_operands = "-1";
-	actions[13].destination_operands = "0,1,2,3";
+#include "actions.h"
 
-	actions[14].action_name = "rts";
-	actions[14].action_code = 14;
-	actions[14].source_operands = "-1";
-	actions[14].destination_operands = "1,2";
+/* The actions, in the order of their codes*/
+static const Action actions[NUM_OF_ACTIONS] = {
+	{ "mov", 0, 2, ADDRESSING_IMMEDIATE | ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER, ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER },
+	{ "cmp", 1, 2, ADDRESSING_IMMEDIATE | ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER, ADDRESSING_IMMEDIATE | ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER },
+	{ "add", 2, 2, ADDRESSING_IMMEDIATE | ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER, ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER },
+	{ "sub", 3, 2, ADDRESSING_IMMEDIATE | ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER, ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER },
+	{ "lea", 4, 2, ADDRESSING_DIRECT, ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER },
+	{ "clr", 5, 1, ADDRESSING_NONE, ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER },
+	{ "not", 6, 1, ADDRESSING_NONE, ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER },
+	{ "inc", 7, 1, ADDRESSING_NONE, ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER },
+	{ "dec", 8, 1, ADDRESSING_NONE, ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER },
+	{ "jmp", 9, 1, ADDRESSING_NONE, ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER },
+	{ "bne", 10, 1, ADDRESSING_NONE, ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER },
+	{ "red", 11, 1, ADDRESSING_NONE, ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER },
+	{ "prn", 12, 1, ADDRESSING_NONE, ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER },
+	{ "jsr", 13, 1, ADDRESSING_NONE, ADDRESSING_IMMEDIATE | ADDRESSING_DIRECT | ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER },
+	{ "rts", 14, 0, ADDRESSING_NONE, ADDRESSING_NONE },
+	{ "stop", 15, 0, ADDRESSING_NONE, ADDRESSING_NONE }
+};
+
+/* Perfect hash of the action names: the slot of a name is (5 * name[0] + 6 * name[1] + name[2]) % 32,
+ * no two actions share a slot. Each slot holds the code of its action, or -1.
+ * The multipliers were found by trying every pair below 64 with a table of 32 slots,
+ * any change to the actions requires finding them again*/
+static const signed char action_slots[ACTIONS_HASH_SIZE] = {
+	-1, 2, -1, 10, 7, 14, 15, -1, -1, 5, 12, -1, -1, 1, -1, -1,
+	9, 0, -1, -1, 6, 8, 13, -1, -1, -1, -1, 4, 11, -1, -1, 3
+};
 
-	actions[15].action_name = "stop";
-	actions[15].action_code = 15;
-	actions[15].source_operands = "-1";
-	actions[15].destination_operands = "-1";
-}
 /**
  * print_actions -
- * Prints the details of each action in an array of Action structures.
+ * Prints the details of each action.
  * Used only for work purposes
-
- * @param actions A pointer to the array of Action structures to be printed.
  */
-void print_actions(Action* actions) {
+void print_actions(void) {
 	int i;
 	for (i = 0; i < NUM_OF_ACTIONS; i++) {
 		printf("Action: %s\n", actions[i].action_name);
-		printf("Source Operands: %s\n", actions[i].source_operands);
-		printf("Destination Operands: %s\n", actions[i].destination_operands);
+		printf("Source Operands: %d\n", actions[i].source_modes);
+		printf("Destination Operands: %d\n", actions[i].destination_modes);
 		printf("\n");
 	}
 }
 
-/* Function to get source operands by action name*/
 /**
- * get_source_operands -
- *  Retrieves the source operands for a specified action.
+ * find_action -
+ * Retrieves the action of a name with one probe of the actions' perfect hash.
  *
- * @param actions A pointer to the array of Action structures.
  * @param action_name The name of the action to search for (e.g., "mov", "add").
- * @return A pointer to the string of source operands if the action is found,
- *         or NULL if the action name is not found.
+ * @return The action, or NULL if the name is not an action.
  */
-char* get_source_operands(Action* actions, char* action_name) {
-	int i;
-	/* Iterate through each action in the array and compare the current action's name with the provided action name*/
-	for (i = 0; i < NUM_OF_ACTIONS; i++) {
-		if (strcmp(actions[i].action_name, action_name) == 0) {
-			/*A match is found*/
-			return actions[i].source_operands;
-		}
+const Action* find_action(const char* action_name) {
+	int slot;
+	/* Every action name has at least 3 characters*/
+	if (action_name[0] == '\0' || action_name[1] == '\0') {
+		return NULL;
 	}
-	return NULL; /* Return NULL if action name not found*/
-}
-
-/**
- * get_destination_operands -
- * Retrieves the destination operands for a specified action.
- *
- * @param actions A pointer to the array of Action structures.
- * @param action_name The name of the action to search for (e.g., "mov", "add").
- * @return A pointer to the string of destination operands if the action is found,
- *         or NULL if the action name is not found.
- */
-char* get_destination_operands(Action* actions, char* action_name) {
-	int i;
-	for (i = 0; i < NUM_OF_ACTIONS; i++) {
-		if (strcmp(actions[i].action_name, action_name) == 0) {
-			/* Action name is found*/
-			return actions[i].destination_operands;
-		}
+	slot = action_slots[((unsigned char)action_name[0] * 5 + (unsigned char)action_name[1] * 6 + (unsigned char)action_name[2]) % ACTIONS_HASH_SIZE];
+	if (slot < 0 || strcmp(actions[slot].action_name, action_name) != 0) {
+		return NULL;
 	}
-	return NULL; /* Return NULL if action name not found*/
-}
-
-/**
- * get_action_code -
- * Retrieves the action code by action name.
- *
- * @param actions A pointer to the array of Action structures.
- * @param action_name The name of the action to search for (e.g., "mov", "add").
- * @return A pointer to the action code cast as a `char*` if the action is found,
- *         or NULL if the action name is not found.
- */
-int get_action_code(Action* actions, char* action_name) {
-	int i;
-	for (i = 0; i < NUM_OF_ACTIONS; i++) {
-		if (strcmp(actions[i].action_name, action_name) == 0) {
-			/*Action name found*/
-			return actions[i].action_code;
-		}
-	}
-	return -1; /* Return NULL if action name not found*/
+	return &actions[slot];
 }
 
 /**
  * action_exists -
  * Checks if a string exists as an action name.
  *
- * @param actions A pointer to the array of Action structures.
  * @param action_name The name of the action to search for (e.g., "mov", "add").
  * @return FOUND if the action name is found, or NOT_FOUND if it is not found.
  */
-int action_exists(Action* actions, char* action_name) {
-	int i;
-	for (i = 0; i < NUM_OF_ACTIONS; i++) {
-		if (strcmp(actions[i].action_name, action_name) == 0) {
-			return FOUND; /* Action name found*/
-		}
-	}
-	return NOT_FOUND; /* Action name not found*/
-}
\ No newline at end of file
+int action_exists(const char* action_name) {
+	return find_action(action_name) != NULL ? FOUND : NOT_FOUND; /* Action name found*/
+}
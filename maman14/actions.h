@@ -8,32 +8,33 @@
 #include "constants.h"
 #include "error_manager.h"
 
+/* Addressing modes an operand of an action may use, one bit for each mode number*/
+#define ADDRESSING_IMMEDIATE 1         /* Mode 0*/
+#define ADDRESSING_DIRECT 2            /* Mode 1*/
+#define ADDRESSING_INDIRECT_REGISTER 4 /* Mode 2*/
+#define ADDRESSING_DIRECT_REGISTER 8   /* Mode 3*/
+#define ADDRESSING_NONE 0              /* The action has no such operand*/
+
+#define ACTIONS_HASH_SIZE 32
+
 /* Define a struct to hold the action details*/
 typedef struct {
-	char* action_name;
+	const char* action_name;
 	int action_code;
-	char* source_operands;
-	char* destination_operands;
+	int operand_count;
+	int source_modes;      /* ADDRESSING_* bits allowed for the source operand*/
+	int destination_modes; /* ADDRESSING_* bits allowed for the destination operand*/
 } Action;
 
 
 
 /* Function to print the actions - used during work not nusseccary*/
-void print_actions(Action* actions);
-
-/* Function to get source operands by action name*/
-char* get_source_operands(Action* actions, char* action_name);
+void print_actions(void);
 
-/* Function to get destination operands by action name*/
-char* get_destination_operands(Action* actions, char* action_name);
-
-/* Function to get action code by action name*/
-int get_action_code(Action* actions, char* action_name);
+/* Function to get the action of a name, NULL if there is no such action*/
+const Action* find_action(const char* action_name);
 
 /* Function to get if action exists by action name*/
-int action_exists(Action* actions, char* action_name);
+int action_exists(const char* action_name);
 
-void intialize_actions_array(Action* actions);
 #endif /* ACTIONS_H*/
-
-
@@ -11,22 +11,196 @@
 #include "constants.h"
 #include "error_manager.h"
 #include "operands.h"
+#include "memory_manager.h"
+#include "pipeline_manager.h"
+#include "job_manager.h"
+#include "stats_manager.h"
+#include "trace_manager.h"
+
+
+/* What every file shares, read only*/
+typedef struct {
+	Registers* registers;
+	Registers_2* registers_2;
+} AssemblerContext;
+
+
+/**
+ * assemble_file -
+ * Job that assembles one file, or only expands its macros with -E.
+ * All the managers of the file are its own, only the tables of the context are shared.
+ *
+ * @param job The file to assemble.
+ * @param context Pointer to the AssemblerContext.
+ */
+static void assemble_file(Job* job, void* context) {
+	AssemblerContext* shared = (AssemblerContext*)context;
+	FileManager fileManager;
+	MacroManager macroManager;
+	Arena arena;
+	Arena scan_arena;
+	Allocator allocator;
+	Allocator scan_allocator;
+	AssemblerManager* assemblerManager;
+	SymbolsManager* symbolsManager;
+	FileStats* stats = &job->stats;
+
+	init_file_stats(stats);
+
+	/*-E only expands the macros, streaming the post-macro file*/
+	if (job->preprocess_only) {
+		begin_phase(stats, InputPhase);
+		stream_post_macro(job->file_name, job->post_macro_format);
+		end_phase(stats, InputPhase);
+		return;
+	}
+
+	/*All the memory of this file is taken from two allocators, one for the macro stage and one for the scans,
+	so the two stages can run at the same time*/
+	init_arena(&arena);
+	init_arena(&scan_arena);
+	init_allocator(&allocator, job->allocator, &arena);
+	init_allocator(&scan_allocator, job->allocator, &scan_arena);
+	stats->macro_allocator = &allocator;
+	stats->scan_allocator = &scan_allocator;
+
+	/*Initialize a FileManager*/
+	initialize_file_manager(&fileManager, &allocator);
+
+	/*Initialize a MacroManager*/
+	init_macro_manager(&macroManager, &allocator);
+
+	/*Create assemblerManager*/
+	assemblerManager = createAssemblerManager(&scan_allocator);
+	/*Create symbolsManager*/
+	symbolsManager = createSymbolsManager(&scan_allocator);
+
+	/*Check legality of file name*/
+	/*Process files provided by the user, the first scan takes the lines while the macros are expanded*/
+	if (assemblerManager != NULL && symbolsManager != NULL &&
+		run_first_pass(&fileManager, &macroManager, job->file_name, assemblerManager, symbolsManager, shared->registers, shared->registers_2, stats))
+	{
+
+		/*Only if reading the file and creating the post-macro file worked, then continue*/
+
+		/*print_post_macro(&fileManager);*//*Use only for work, asked only to print to file*/
+
+		begin_phase(stats, PostMacroPhase);
+		if (printPostMacroToFile(job->file_name, &fileManager, job->post_macro_format)) {
+			end_phase(stats, PostMacroPhase);
+			begin_phase(stats, DataLocationPhase);
+			updateLocationDataSymbols(symbolsManager, assemblerManager);
+			updateDataItemsLocation(assemblerManager);
+			end_phase(stats, DataLocationPhase);
+
+
+			begin_phase(stats, SecondScanPhase);
+			second_scan(assemblerManager, symbolsManager);
+			end_phase(stats, SecondScanPhase);
+			if (assemblerManager->has_assembler_errors == NOT_FOUND && symbolsManager->has_symbols_errors == NOT_FOUND)
+			{
+				/*Can print output files*/
+				begin_phase(stats, ObjectPhase);
+				printObjToFile(job->file_name, assemblerManager);
+				end_phase(stats, ObjectPhase);
+				begin_phase(stats, ReferencesPhase);
+				printReferenceSymbolsToFile(job->file_name, symbolsManager);
+				end_phase(stats, ReferencesPhase);
+				stats->words = assemblerManager->actionItemCount + assemblerManager->dataItemCount;
+			}
+		}
+	}
+	stats->lines = fileManager.source_lines;
+	stats->tokens = fileManager.source_tokens;
+	stats->macro_expansions = fileManager.macro_expansions;
+	if (assemblerManager != NULL && symbolsManager != NULL) {
+		stats->symbols = symbolsManager->used;
+		stats->fixups = assemblerManager->fixupCount;
+	}
+	count_file_allocators(stats);
+
+	/*Release everything the file used*/
+	release_allocator(&scan_allocator);
+	release_allocator(&allocator);
+}
+
+
+/**
+ * parse_job_count -
+ * Reads the number of files to assemble at the same time.
+ *
+ * @param text The number, as given after -j.
+ * @return The number, or 0 if it is not a positive number.
+ */
+static int parse_job_count(const char* text) {
+	int count = 0;
+
+	if (text == NULL || *text == '\0') {
+		return 0;
+	}
+	for (; *text != '\0'; text++) {
+		if (*text < '0' || *text > '9' || count > MAX_JOB_THREADS) {
+			return 0;
+		}
+		count = count * 10 + (*text - '0');
+	}
+	return count;
+}
+
+
+/**
+ * parse_post_macro_format -
+ * Reads how the .am files are written.
+ *
+ * @param text The format, as given after --am=.
+ * @param format Set to the format.
+ * @return FOUND if the format is known, NOT_FOUND otherwise.
+ */
+static int parse_post_macro_format(const char* text, PostMacroFormat* format) {
+	if (strcmp(text, "table") == 0) {
+		*format = PostMacroTable;
+	}
+	else if (strcmp(text, "plain") == 0) {
+		*format = PostMacroPlain;
+	}
+	else if (strcmp(text, "none") == 0) {
+		*format = PostMacroNone;
+	}
+	else {
+		return NOT_FOUND;
+	}
+	return FOUND;
+}
 
 
 /*
 This program is an assembler for the assembly language.
 The program receives an input file containing a program written in assembly language. The role of the assembler is to build from this a file containing machine code.
+With --am=plain the .am files hold plain lines instead of a table, with --am=none they are not written.
+With --stats or --stats=json, the time of each phase and counters of each file are printed once all the files are done.
+With --trace=FILE, FILE receives a Chrome trace of when each file and phase ran.
+With --allocator=system, bump or counting, the memory of the files that follow is taken from malloc, from arenas,
+or from arenas that count what each phase asked for, which --stats prints.
+With -j N, N files are assembled at the same time, their errors are printed in the order of the files.
 @param int argc
 @param char** argv
 @return int 0 if OK 1 otherwise
 */
 int main(int argc, char** argv) {
 
-	FileManager fileManager;
-	MacroManager macroManager;
-	Action actions[NUM_OF_ACTIONS];
-	Registers* registers = (Registers*)malloc(NUM_OF_REGISTERS * sizeof(Registers));
-	Registers_2* registers_2 = (Registers_2*)malloc(NUM_OF_REGISTERS * sizeof(Registers_2));
+	Registers registers[NUM_OF_REGISTERS];
+	Registers_2 registers_2[NUM_OF_REGISTERS];
+	AssemblerContext context;
+	Job* jobs;
+	int job_count = 0;
+	int thread_count = 1;
+	int preprocess_only = NOT_FOUND;
+	PostMacroFormat post_macro_format = PostMacroTable;
+	AllocatorKind allocator = DEFAULT_ALLOCATOR;
+	StatsFormat stats_format = NoStats;
+	const char* trace_path = NULL;
+	double origin;
+	int i;
 
 
 
@@ -37,57 +211,105 @@ int main(int argc, char** argv) {
 		return !OK;
 	}
 
+	jobs = (Job*)malloc((argc - 1) * sizeof(Job));
+	if (jobs == NULL) {
+		log_error("main", 148, "assembler.c", "Memory allocation failed");
+		return !OK;
+	}
 
-	intialize_actions_array(actions);
-	initialize_operands(registers, registers_2);
-	/*There is at least 1 file name. Start reading*/
-	while (--argc > 0)
+	/*Read all the arguments before starting, the options apply to the files that follow them*/
+	for (i = 1; i < argc; i++)
 	{
-		/*Initialize a FileManager*/
-		initialize_file_manager(&fileManager);
-
-		/*Initialize a MacroManager*/
-		init_macro_manager(&macroManager);
-
-		/*Check legality of file name*/
-		/*Process files provided by the user*/
-		if (input_process(&fileManager, &macroManager, *++argv))
-		{
-
-			/*Only if reading the file and creating the post-macro file worked, then continue*/
-
-			/*print_post_macro(&fileManager);*//*Use only for work, asked only to print to file*/
-
-			if (printPostMacroToFile(*argv, &fileManager)) {
-
-				/*Create assemblerManager*/
-				AssemblerManager* assemblerManager = createAssemblerManager();
-				if (assemblerManager != NULL)
-				{
-					/*Create symbolsManager*/
-					SymbolsManager* symbolsManager = createSymbolsManager();
-					if (symbolsManager != NULL)
-					{
-						first_scan(&macroManager, &fileManager, assemblerManager, symbolsManager, actions, registers, registers_2);
-						updateLocationDataSymbols(symbolsManager, assemblerManager);
-						updateDataItemsLocation(assemblerManager);
-
-
-						second_scan(assemblerManager, symbolsManager);
-						if (assemblerManager->has_assembler_errors == NOT_FOUND && symbolsManager->has_symbols_errors == NOT_FOUND)
-						{
-							/*Can print output files*/
-							printObjToFile(*argv, assemblerManager);
-							printReferenceSymbolsToFile(*argv, symbolsManager);
-						}
-					}
-				}
+		/*-E only expands the macros of the files that follow, streaming the post-macro file*/
+		if (strcmp(argv[i], "-E") == 0) {
+			preprocess_only = FOUND;
+			continue;
+		}
+		/*--am=table, --am=plain or --am=none sets how the .am files of the files that follow are written*/
+		if (strncmp(argv[i], "--am=", 5) == 0) {
+			if (!parse_post_macro_format(argv[i] + 5, &post_macro_format)) {
+				log_error("main", 190, "assembler.c", "--am must be table, plain or none");
+				free(jobs);
+				return !OK;
+			}
+			continue;
+		}
+		/*--allocator=system, bump or counting sets where the memory of the files that follow is taken from*/
+		if (strncmp(argv[i], "--allocator=", 12) == 0) {
+			if (!find_allocator_kind(argv[i] + 12, &allocator)) {
+				log_error("main", 240, "assembler.c", "--allocator must be system, bump or counting");
+				free(jobs);
+				return !OK;
+			}
+			continue;
+		}
+		/*--stats prints what each file took as text, --stats=json as a JSON array*/
+		if (strcmp(argv[i], "--stats") == 0 || strcmp(argv[i], "--stats=text") == 0) {
+			stats_format = TextStats;
+			continue;
+		}
+		if (strcmp(argv[i], "--stats=json") == 0) {
+			stats_format = JsonStats;
+			continue;
+		}
+		/*--trace=FILE writes when each file and phase ran, on which thread, as a Chrome trace*/
+		if (strncmp(argv[i], "--trace=", 8) == 0 && argv[i][8] != '\0') {
+			trace_path = argv[i] + 8;
+			continue;
+		}
+		/*-j N or -jN sets how many files are assembled at the same time*/
+		if (strncmp(argv[i], "-j", 2) == 0) {
+			thread_count = parse_job_count(argv[i][2] != '\0' ? argv[i] + 2 : (i + 1 < argc ? argv[++i] : NULL));
+			if (thread_count == 0) {
+				log_error("main", 164, "assembler.c", "-j needs a positive number of jobs");
+				free(jobs);
+				return !OK;
 			}
+			continue;
 		}
-		free_file_manager(&fileManager);
+		jobs[job_count].file_name = argv[i];
+		jobs[job_count].preprocess_only = preprocess_only;
+		jobs[job_count].post_macro_format = post_macro_format;
+		jobs[job_count].allocator = allocator;
+		job_count++;
 	}
-	return OK;
 
-}
+	if (job_count == 0)
+	{
+		log_error("main", 177, "assembler.c", "There isn't any file name as input");
+		free(jobs);
+		return !OK;
+	}
 
+	/*The registers are only read once initialized, all the files share them*/
+	initialize_operands(registers, registers_2);
+	context.registers = registers;
+	context.registers_2 = registers_2;
+
+	origin = stats_time();
+	run_jobs(jobs, job_count, thread_count, assemble_file, &context);
+	if (trace_path != NULL) {
+		write_trace_file(trace_path, jobs, job_count, origin);
+	}
 
+	/*The stats are printed in the order of the files*/
+	if (stats_format == JsonStats) {
+		printf("[");
+	}
+	for (i = 0; i < job_count && stats_format != NoStats; i++) {
+		if (stats_format == JsonStats) {
+			printf(i > 0 ? ",\n " : "\n ");
+			print_stats_json(stdout, jobs[i].file_name, &jobs[i].stats);
+		}
+		else {
+			print_stats_text(stdout, jobs[i].file_name, &jobs[i].stats);
+		}
+	}
+	if (stats_format == JsonStats) {
+		printf("\n]\n");
+	}
+
+	free(jobs);
+	return OK;
+
+}
@@ -4,48 +4,46 @@
  * createAssemblerManager -
  * Creates and initializes a new AssemblerManager instance.
  *
+ * @param allocator The allocator that owns the AssemblerManager's memory.
  * @return AssemblerManager* A pointer to the newly created and initialized AssemblerManager instance.
  */
-AssemblerManager* createAssemblerManager() {
-	AssemblerManager* manager = (AssemblerManager*)malloc(sizeof(AssemblerManager));
+AssemblerManager* createAssemblerManager(Allocator* allocator) {
+	AssemblerManager* manager = (AssemblerManager*)allocate_memory(allocator, sizeof(AssemblerManager));
 	/*Failed to create AssemblerManager*/
 	if (manager == NULL) {
 		log_error("createAssemblerManager", 13, "assembler_manager.c", "Failed to create AssemblerManager");
 		return NULL;
 	}
 	/*created AssemblerManager successfully*/
+	manager->allocator = allocator;
 	manager->IC = 0;
 	manager->DC = 0;
 	manager->has_assembler_errors = NOT_FOUND;
 	manager->dataItems = NULL;
 	manager->dataItemCount = 0;
+	manager->dataItemSize = 0;
 	manager->actionItems = NULL;
 	manager->actionItemCount = 0;
+	manager->actionItemSize = 0;
+	manager->fixups = NULL;
+	manager->fixupCount = 0;
+	manager->fixupSize = 0;
 	return manager;
 }
 
-/**
- * destroyAssemblerManager -
- * Frees the memory allocated for an AssemblerManager structure.
- *
- * @param manager A pointer to the AssemblerManager structure to be destroyed.
- */
-void destroyAssemblerManager(AssemblerManager* manager) {
-	free(manager->dataItems);
-	free(manager->actionItems);
-	free(manager);
-}
-
 /**
  * first_scan -
  * Performs the first scan of the file data and updates the symbol and assembler managers.
  *
- * This function iterates through each row of data in the FileManager's `post_macro` array and
+ * This function iterates through each line of the FileManager's post-macro table and
  * performs processing based on the type of pattern detected in each row. It updates the SymbolsManager
- * with information about symbols, actions, data, and references and updates the AssemblerManager accordingly.
+ * with information about symbols, data, and references and updates the AssemblerManager accordingly.
+ * Once all the lines are scanned, the labels that are macro names are reported.
+ *
+ * @param macroManager A pointer to the MacroManager holding the macros of the file.
  *
- * @param fileManager A pointer to a FileManager instance containing the data to be scanned. The `post_macro` field
- * is expected to be an array of strings, each representing a line of the file.
+ * @param fileManager A pointer to a FileManager instance containing the data to be scanned. Each of its lines
+ * is a NULL-terminated array of the line's tokens.
  *
  * @param assemblerManager A pointer to an AssemblerManager instance that keeps track of the current instruction counter (IC)
  * and data counter (DC). This is used to update counters based on the type of data encountered.
@@ -53,48 +51,87 @@ void destroyAssemblerManager(AssemblerManager* manager) {
  * @param symbolsManager A pointer to a SymbolsManager instance used to manage and update symbol-related information
  * based on the patterns detected in the file data.
  */
-void first_scan(MacroManager* macroManager, FileManager* fileManager, AssemblerManager* assemblerManager, SymbolsManager* symbolsManager, Action* actions, Registers* registers, Registers_2* registers_2) {
+void first_scan(MacroManager* macroManager, FileManager* fileManager, AssemblerManager* assemblerManager, SymbolsManager* symbolsManager, Registers* registers, Registers_2* registers_2) {
 	int i;
 	/* Iterate through each row of the file data */
 	for (i = 0; i < fileManager->row_count; ++i) {
-		char** line = fileManager->post_macro[i];
-		/*If the line starts with ; it's a comment move to next line*/
-		if (strcmp(line[0], ";") == 0 || strcmp(line[0], "file") == 0) {
-			continue;
-		}
+		first_scan_line(get_post_macro_line(fileManager, i), assemblerManager, symbolsManager, registers, registers_2);
+	}
+	/* The labels are checked against the macros once, as when the lines are scanned while the macros are expanded*/
+	checkSymbolsMacroNames(macroManager, symbolsManager);
+}
 
-		/* If the pattern is a reference, update the symbol table with a reference */
-		if (isReferencePattern(line[0])) {
-			updateSymbolsTable(macroManager, symbolsManager, line, -1, actions, registers);
-		}
-		/* If the pattern is a symbol and followed by data, update symbol table and process data */
-		else if (isSymbolPattern(line[0])) {
-			if (isDataPattern(line[1])) {
-				updateSymbolsTable(macroManager, symbolsManager, line, assemblerManager->DC, actions, registers);
-				processDataLine(line + 1, assemblerManager);
-			}
-			/* If the pattern is a symbol and followed by an action, update symbol table and process action */
-			else if (action_exists(actions, line[1])) {
-				updateSymbolsTable(macroManager, symbolsManager, line, assemblerManager->IC, actions, registers);
-				processActionLine(actions, line + 1, assemblerManager, registers, registers_2);
-			}
-			else { /*action doesnt exists in allowed actions list*/
-				label_error("first_scan", 82, "assembler_manager.c", "This action doesn't exists, if this is a label, please add ':' at the end", line[0]);
-			}
-		}
-		/* If the pattern is an action, process the action line */
-		else if (action_exists(actions, line[0])) {
-			processActionLine(actions, line, assemblerManager, registers, registers_2);
-		}
-		/* If the pattern is data, process the data line */
-		else if (isDataPattern(line[0])) {
-			processDataLine(line, assemblerManager);
-		}
-		else {
-			/*Action doesn't exists*/
-			label_error("first_scan", 95, "assembler_manager.c", "This action doesn't exists, if this is a label, please add ':' at the end", line[0]);
+/**
+ * first_scan_line -
+ * Performs the first scan of one line of the post-macro program.
+ *
+ * @param line A NULL-terminated array of the line's tokens.
+ * @param assemblerManager A pointer to the AssemblerManager that keeps IC and DC.
+ * @param symbolsManager A pointer to the SymbolsManager that collects the symbols.
+ */
+void first_scan_line(char** line, AssemblerManager* assemblerManager, SymbolsManager* symbolsManager, Registers* registers, Registers_2* registers_2) {
+	/* The line is classified once, the rest of the scan reads the parsed line*/
+	ParsedLine parsed;
+	if (!build_line(&parsed, line, symbolsManager, registers, registers_2)) {
+		return;
+	}
+
+	switch (parsed.type) {
+	case CommentLine: /*If the line starts with ; it's a comment move to next line*/
+		break;
+	case ExternLine:
+	case EntryLine: /* If the pattern is a reference, update the symbol table with a reference */
+		updateSymbolsTable(symbolsManager, &parsed, -1, registers);
+		break;
+	case DataLine:
+	case StringLine: /* If the pattern is data, update symbol table if there is a label and process data */
+		updateSymbolsTable(symbolsManager, &parsed, assemblerManager->DC, registers);
+		processDataLine(&parsed, assemblerManager);
+		break;
+	case ActionLine: /* If the pattern is an action, update symbol table if there is a label and process action */
+		updateSymbolsTable(symbolsManager, &parsed, assemblerManager->IC, registers);
+		processActionLine(&parsed, assemblerManager);
+		break;
+	default: /*action doesnt exists in allowed actions list*/
+		label_error("first_scan_line", 90, "assembler_manager.c", "This action doesn't exists, if this is a label, please add ':' at the end", line[0]);
+		break;
+	}
+}
 
+/**
+ * addOperandItem -
+ * Adds the word of an operand, the word is encoded straight into its item.
+ *
+ * @param assemblerManager A pointer to the AssemblerManager that manages the assembly process.
+ * @param operand The operand.
+ * @param source_register_number The source register of a register word, NO_REGISTER if there is none.
+ * @param dest_register_number The destination register of a register word, NO_REGISTER if there is none.
+ */
+static void addOperandItem(AssemblerManager* assemblerManager, const ParsedOperand* operand, int source_register_number, int dest_register_number) {
+	Word* slot;
+	int is_encoded = FOUND;
+
+	if (operand->addressing == Direct) {
+		/* The word is known only in the second scan*/
+		if (addActionItem(assemblerManager, operand->text) != NULL) {
+			addFixup(assemblerManager, operand->symbol);
 		}
+		return;
+	}
+
+	slot = addActionItem(assemblerManager, "");
+	if (slot == NULL) {
+		return;
+	}
+	if (operand->addressing == Immediate) {
+		is_encoded = generate_immediate_line(slot, operand->value);
+	}
+	else {
+		is_encoded = generate_register_line(slot, source_register_number, dest_register_number);
+	}
+	if (!is_encoded) {
+		label_error("addOperandItem", 125, "assembler_manager.c", "Operand is out of range", operand->text);
+		assemblerManager->has_assembler_errors = FOUND;
 	}
 }
 
@@ -102,158 +139,152 @@ void first_scan(MacroManager* macroManager, FileManager* fileManager, AssemblerM
  * processActionLine -
  * Processes a single line of assembly code that contains an action.
  *
- * This function analyzes an assembly line, determines the types of operands,
- * and generates the corresponding machine code. It then adds the generated code
- * to the assembler's instruction set.
+ * This function reads the operands of a parsed action line and encodes the
+ * corresponding machine code straight into the assembler's instruction set,
+ * without any allocation.
  *
- * @param actions A pointer to the array of Action structures.
- * @param line A double pointer to the line of assembly code being processed.
+ * @param parsed The action line, as built by build_line.
  * @param assemblerManager A pointer to the AssemblerManager that manages the assembly process.
  */
-void processActionLine(Action* actions, char** line, AssemblerManager* assemblerManager, Registers* registers, Registers_2* registers_2) {
-	int reg_dest_was_handled = NOT_FOUND;
-
-	char* first_line = process_first_line(actions, line, registers);
-	char* action_name = clone_string(line[0]);
-	char* source_operands = get_source_operands(actions, action_name);
-	char* destination_operands = get_destination_operands(actions, action_name);
-	int has_source_operands = strcmp(source_operands, "-1") != 0;
-	int has_dest_operands = strcmp(destination_operands, "-1") != 0;
-	int source_reg_num, dest_reg_num, number, location_of_current_operand;
-	char* line_to_add;
-	AddressingType	addressing_type_dest;
-
-	addActionItem(assemblerManager, line[0], assemblerManager->IC, first_line);
-	if (has_source_operands) { /* there are source_operands for this action*/
-		AddressingType	addressing_type_source = get_addressing_type(registers, registers_2, line[1]);
-		if (addressing_type_source == DirectRegister || addressing_type_source == IndirectRegister) {
-			source_reg_num = addressing_type_source == DirectRegister ? line[1][1] - '0' : line[1][2] - '0';
-			if (has_dest_operands) {
-				AddressingType	addressing_type_dest = get_addressing_type(registers, registers_2, line[2]);
-				if (addressing_type_dest == DirectRegister || addressing_type_dest == IndirectRegister) {
-					reg_dest_was_handled = FOUND;
-					dest_reg_num = addressing_type_dest == DirectRegister ? line[2][1] - '0' : line[2][2] - '0';
-					line_to_add = generate_combined_register_line(source_reg_num, dest_reg_num); /* pass the reg number without * sign*/
-					addActionItem(assemblerManager, "", assemblerManager->IC, line_to_add);
-
-				}
-				else {/*DirectRegister or IndirectRegister in source and there is a dest but not DirectRegister or IndirectRegister in dest*/
-					line_to_add = generate_single_register_line(source_reg_num, FOUND); /* pass the reg number without * sign*/
-					addActionItem(assemblerManager, "", assemblerManager->IC, line_to_add);
-				}
-			}
-			else { /* DirectRegister or IndirectRegister in source but no dest operands at all*/
-				line_to_add = generate_single_register_line(source_reg_num, FOUND); /* pass the reg number without * sign*/
-				addActionItem(assemblerManager, "", assemblerManager->IC, line_to_add);
-			}
-		}
-		else { /* not DirectRegister or IndirectRegister in source only Immediate or Direct*/
-			switch (addressing_type_source)
-			{
-			case Immediate: {
-				number = atoi(line[1] + 1);
-				line_to_add = generate_immediate_line(number);
-				addActionItem(assemblerManager, "", assemblerManager->IC, line_to_add);
-				break;
-			}
-			case Direct: {
-				addActionItem(assemblerManager, "LABEL", assemblerManager->IC, line[1]);
-				break;
-			}
-			case IndirectRegister:
-			case DirectRegister:
-				break;
-			}
-		}
+void processActionLine(const ParsedLine* parsed, AssemblerManager* assemblerManager) {
+	const Action* action = parsed->action;
+	int has_source_operands = action->source_modes != ADDRESSING_NONE;
+	int has_dest_operands = action->destination_modes != ADDRESSING_NONE;
+	/* The source is written first, the destination follows it*/
+	const ParsedOperand* source = has_source_operands ? &parsed->operands[0] : NULL;
+	const ParsedOperand* dest = has_dest_operands ? &parsed->operands[has_source_operands ? 1 : 0] : NULL;
+	Word* first_word;
+
+	if (parsed->operand_count < has_source_operands + has_dest_operands) {
+		label_error("processActionLine", 151, "assembler_manager.c", "Missing operand", parsed->words[0]);
+		assemblerManager->has_assembler_errors = FOUND;
+		return;
 	}
-	if (has_dest_operands) { /* handle dest operands, but skip DirectRegister and IndirectRegister if already handled*/
-		location_of_current_operand = has_source_operands ? 2 : 1;
-		addressing_type_dest = get_addressing_type(registers, registers_2, line[location_of_current_operand]);
-		switch (addressing_type_dest)
-		{
-		case Immediate: {
-			number = atoi(line[location_of_current_operand] + 1);
-			line_to_add = generate_immediate_line(number);
-			addActionItem(assemblerManager, "", assemblerManager->IC, line_to_add);
-			break;
-		}
-		case Direct: {
-			addActionItem(assemblerManager, "LABEL", assemblerManager->IC, line[location_of_current_operand]);
-			break;
-		}
-		default: {
-			if (!reg_dest_was_handled) { /* combined row was handled before*/
-				dest_reg_num = addressing_type_dest == DirectRegister ? line[location_of_current_operand][1] - '0' : line[location_of_current_operand][2] - '0';
-				line_to_add = generate_single_register_line(dest_reg_num, NOT_FOUND); /* pass the reg number without * sign*/
-				addActionItem(assemblerManager, "", assemblerManager->IC, line_to_add);
-			}
-		}
-			   break;
-		}
+
+	first_word = addActionItem(assemblerManager, parsed->words[0]);
+	if (first_word == NULL) {
+		return;
+	}
+	if (!process_first_line(first_word, parsed)) {
+		assemblerManager->has_assembler_errors = FOUND;
+		return;
+	}
+
+	/* DirectRegister or IndirectRegister in both source and dest share one word*/
+	if (source != NULL && dest != NULL && source->register_number != NO_REGISTER && dest->register_number != NO_REGISTER) {
+		addOperandItem(assemblerManager, source, source->register_number, dest->register_number);
+		return;
+	}
+	if (source != NULL) {
+		addOperandItem(assemblerManager, source, source->register_number, NO_REGISTER);
+	}
+	if (dest != NULL) {
+		addOperandItem(assemblerManager, dest, NO_REGISTER, dest->register_number);
 	}
 }
 
 
-void processDataLine(char** line, AssemblerManager* assemblerManager) {
-	char** data_lines = generateDataLine(line);
-	int count = 0;
+void processDataLine(const ParsedLine* parsed, AssemblerManager* assemblerManager) {
+	int word_count = 0;
+	Word* data_words = generateDataLine(parsed, &word_count, assemblerManager->allocator);
+	int count;
 
-	if (data_lines == NULL) {
+	if (data_words == NULL) {
 		assemblerManager->has_assembler_errors = FOUND;
 		return;
 	}
 
-	while (data_lines[count] != NULL) {
-		addDataItem(assemblerManager, assemblerManager->DC, data_lines[count]);
-		count++;
+	for (count = 0; count < word_count; count++) {
+		addDataItem(assemblerManager, assemblerManager->DC, data_words[count]);
 		assemblerManager->DC++;
 	}
+	release_memory(assemblerManager->allocator, data_words);
 }
 
 /**
  * addDataItem -
- * Processes a line of assembly code that contains data definitions.
+ * Adds a new data item to the AssemblerManager's data items list.
  *
- * @param line A double pointer to the line of assembly code being processed.
- * @param assemblerManager A pointer to the AssemblerManager that manages the assembly process.
+ * @param manager A pointer to the AssemblerManager that manages data items.
+ * @param location The location (address) of the data item in the data counter (DC).
+ * @param word The word of the data item.
  */
-void addDataItem(AssemblerManager* manager, int location, const char* value) {
-	manager->dataItems = (Item*)realloc(manager->dataItems, (manager->dataItemCount + 1) * sizeof(Item));
-	if (manager->dataItems == NULL) {
-		log_error("addDataItem", 223, "assembler_manager.c", "Failed to add data item");
-		manager->has_assembler_errors = FOUND;
-		return;
+void addDataItem(AssemblerManager* manager, int location, Word word) {
+	Item* item;
+	/* Double the size of the data items array when it is full*/
+	if (manager->dataItemCount == manager->dataItemSize) {
+		int new_size = manager->dataItemSize ? manager->dataItemSize * 2 : ITEMS_INITIAL_SIZE;
+		Item* new_items = (Item*)resize_memory(manager->allocator, manager->dataItems, new_size * sizeof(Item));
+		if (new_items == NULL) {
+			log_error("addDataItem", 248, "assembler_manager.c", "Failed to add data item");
+			manager->has_assembler_errors = FOUND;
+			return;
+		}
+		manager->dataItems = new_items;
+		manager->dataItemSize = new_size;
 	}
-	manager->dataItems[manager->dataItemCount].location = location;
-	manager->dataItems[manager->dataItemCount].octal = bitStringToOctal(value);
-	strncpy(manager->dataItems[manager->dataItemCount].value, value, WORD_SIZE_IN_BITS);
-	manager->dataItems[manager->dataItemCount].value[WORD_SIZE_IN_BITS] = '\0';
+	item = &manager->dataItems[manager->dataItemCount];
+	item->location = location;
+	item->metadata = "";
+	item->word = word;
 	manager->dataItemCount++;
 }
 
 /**
  * addActionItem -
- * Adds a new action item to the AssemblerManager's action items list.
+ * Adds a new action item to the AssemblerManager's action items list, at the instruction counter (IC).
+ * The item's word is 0 until the caller encodes it in the returned slot.
  *
  * @param manager A pointer to the AssemblerManager that manages action items.
- * @param metadata A string containing metadata associated with the action item (e.g., label or comment).
- * @param location The location (address) of the action item in the instruction counter (IC).
- * @param value A string representing the machine code or value of the action item.
+ * @param metadata The action of a first word or the label of a label operand, "" otherwise.
+ * @return The slot of the item's word, or NULL if memory allocation failed.
  */
-void addActionItem(AssemblerManager* manager, char* metadata, int location, const char* value) {
-	manager->actionItems = (Item*)realloc(manager->actionItems, (manager->actionItemCount + 1) * sizeof(Item));
-	if (manager->actionItems == NULL) {
-		label_error("addActionItem", 246, "assembler_manager.c", "Failed to add action item", value);
-		manager->has_assembler_errors = FOUND;
-		return;
+Word* addActionItem(AssemblerManager* manager, const char* metadata) {
+	Item* item;
+	/* Double the size of the action items array when it is full*/
+	if (manager->actionItemCount == manager->actionItemSize) {
+		int new_size = manager->actionItemSize ? manager->actionItemSize * 2 : ITEMS_INITIAL_SIZE;
+		Item* new_items = (Item*)resize_memory(manager->allocator, manager->actionItems, new_size * sizeof(Item));
+		if (new_items == NULL) {
+			label_error("addActionItem", 278, "assembler_manager.c", "Failed to add action item", metadata);
+			manager->has_assembler_errors = FOUND;
+			return NULL;
+		}
+		manager->actionItems = new_items;
+		manager->actionItemSize = new_size;
 	}
-	manager->actionItems[manager->actionItemCount].location = 100 + location;
-	manager->actionItems[manager->actionItemCount].octal = bitStringToOctal(value);
-	strncpy(manager->actionItems[manager->actionItemCount].value, value, WORD_SIZE_IN_BITS);
-	manager->actionItems[manager->actionItemCount].value[WORD_SIZE_IN_BITS] = '\0';
-	manager->actionItems[manager->actionItemCount].metadata = metadata;
+	item = &manager->actionItems[manager->actionItemCount];
+	item->location = FIRST_MEMORY_PLACE + manager->IC;
+	item->metadata = metadata;
+	item->word = 0;
 	manager->actionItemCount++;
 	manager->IC++;
+	return &item->word;
+}
+
+/**
+ * addFixup -
+ * Records that the word of the last action item is the location of a label.
+ *
+ * @param manager A pointer to the AssemblerManager that manages action items.
+ * @param symbol The label's atom in the SymbolsManager.
+ */
+void addFixup(AssemblerManager* manager, Atom symbol) {
+	/* Double the size of the fixups array when it is full*/
+	if (manager->fixupCount == manager->fixupSize) {
+		int new_size = manager->fixupSize ? manager->fixupSize * 2 : FIXUPS_INITIAL_SIZE;
+		Fixup* new_fixups = (Fixup*)resize_memory(manager->allocator, manager->fixups, new_size * sizeof(Fixup));
+		if (new_fixups == NULL) {
+			log_error("addFixup", 275, "assembler_manager.c", "Failed to add fixup");
+			manager->has_assembler_errors = FOUND;
+			return;
+		}
+		manager->fixups = new_fixups;
+		manager->fixupSize = new_size;
+	}
+	manager->fixups[manager->fixupCount].item = manager->actionItemCount - 1;
+	manager->fixups[manager->fixupCount].symbol = symbol;
+	manager->fixupCount++;
 }
 
 /**
@@ -268,19 +299,19 @@ void addActionItem(AssemblerManager* manager, char* metadata, int location, cons
 void printItems(const Item* items, int itemCount, int includeMetadata) {
 	int i;
 	if (includeMetadata) {
-		printf("| Location | Value           | Metadata    | Octal |\n");
-		printf("|----------|-----------------|-------------|-------|\n");
+		printf("| Location | Word  | Metadata    | Octal |\n");
+		printf("|----------|-------|-------------|-------|\n");
 
 		for (i = 0; i < itemCount; ++i) {
-			printf("| %8d | %-15s | %-11s | %5s |\n", items[i].location, items[i].value, items[i].metadata ? items[i].metadata : "", items[i].octal);
+			printf("| %8d | %5u | %-11s | %05o |\n", items[i].location, items[i].word, items[i].metadata ? items[i].metadata : "", items[i].word);
 		}
 	}
 	else {
-		printf("| Location | Value           | Octal |\n");
-		printf("|----------|-----------------|-------|\n");
+		printf("| Location | Word  | Octal |\n");
+		printf("|----------|-------|-------|\n");
 
 		for (i = 0; i < itemCount; ++i) {
-			printf("| %8d | %-15s | %5s |\n", items[i].location, items[i].value, items[i].octal);
+			printf("| %8d | %5u | %05o |\n", items[i].location, items[i].word, items[i].word);
 		}
 	}
 }
@@ -349,197 +380,181 @@ void updateDataItemsLocation(const AssemblerManager* manager) {
  * second_scan -
  * Processes and updates action items and entry symbols during the second scan.
  *
- * This function performs a second scan over the action items in the AssemblerManager and updates
- * their metadata and values based on the symbols found in the SymbolsManager. It also processes
- * entry symbols and updates the reference symbols accordingly.
+ * This function resolves the fixups recorded by the first scan, filling the word of each label
+ * operand from the symbols found in the SymbolsManager, so its cost depends only on the number of
+ * label operands. It also processes entry symbols and updates the reference symbols accordingly.
  *
- * @param assemblerManager A pointer to an AssemblerManager instance containing action items that need to be processed.
- * The function updates each action item's metadata and value based on its corresponding symbol.
+ * @param assemblerManager A pointer to an AssemblerManager instance containing the fixups of the action items.
+ * The function updates the word of each fixup's action item based on its symbol.
  *
  * @param symbolsManager A pointer to a SymbolsManager instance containing symbol information used for updating action items
  * and handling entry symbols. The function uses this to check symbol existence and retrieve locations.
  */
 void second_scan(AssemblerManager* assemblerManager, SymbolsManager* symbolsManager) {
 	int i;
-	char* location_str;
-	/* Process each action item in the assemblerManager */
-	for (i = 0; i < assemblerManager->actionItemCount; ++i) {
-		Item* actionItem = &assemblerManager->actionItems[i];
-
-		/* Check if the metadata indicates this action item is a label */
-		if (strcmp(actionItem->metadata, "LABEL") == 0) {
-			/*Update metadata to be the value of the action item*/
-			actionItem->metadata = duplicate_string(actionItem->value);  /* Update metadata to be the value*/
-
-			/* Check if the value of the action item is an external symbol */
-			if (isRefExtSymbolExists(symbolsManager, actionItem->value)) {/* this is an ext label*/
-				/*Convert the location to a 15 - bit two's complement string*/
-				char* location_str = int_to_15bit_twos_complement(1);
-				if (location_str == NULL) {
-					assemblerManager->has_assembler_errors = FOUND;
-				}
-				/* Add a new reference symbol to the SymbolsManager*/
-				addReferenceSymbol(symbolsManager, actionItem->value, actionItem->location, FOUND); /* add new item to ref_symbols*/
-				/* Copy the new string into the value array*/
-				strncpy(actionItem->value, location_str, sizeof(actionItem->value) - 1);
-				actionItem->value[sizeof(actionItem->value) - 1] = '\0';  /* Ensure null-termination*/
-
-				/*Convert the bit string to an octal representation*/
-				actionItem->octal = bitStringToOctal(location_str);
-
-				/*Free the dynamically allocated string*/
-				free(location_str);
+	/* Only the words of label operands are missing, each one was recorded as a fixup */
+	for (i = 0; i < assemblerManager->fixupCount; ++i) {
+		const Fixup* fixup = &assemblerManager->fixups[i];
+		Item* actionItem = &assemblerManager->actionItems[fixup->item];
+		const char* symbol_name = atom_name(&symbolsManager->atoms, fixup->symbol);
+		/* One access to the index tells whether the label is external or gives its location*/
+		int symbol_location = NOT_FOUND_SYMBOL;
+		SymbolKind resolved = resolveSymbol(symbolsManager, fixup->symbol, &symbol_location);
+
+		/* Check if the label is an external symbol */
+		if (resolved == ExternalSymbol) {/* this is an ext label*/
+			/* Add a new reference symbol to the SymbolsManager*/
+			addReferenceSymbol(symbolsManager, symbol_name, actionItem->location, FOUND); /* add new item to ref_symbols*/
+			/* The location of an external label is unknown, only its ARE bits are set*/
+			actionItem->word = ARE_EXTERNAL;
+		}
+		else { /* this is ent symbol or just symbol - find its location in symbols table*/
+			if (resolved == UnknownSymbol) {
+				getSymbolLocation(symbolsManager, symbol_name); /* Reports the missing symbol*/
+				symbolsManager->has_symbols_errors = FOUND;
+				continue; /* The other fixups are still checked, so every missing symbol is reported*/
 			}
-			else { /* this is ent symbol or just symbol - find its location in symbols table*/
-				int symbol_location = getSymbolLocation(symbolsManager, actionItem->value);
-				if (symbol_location == NOT_FOUND_SYMBOL) {
-					symbolsManager->has_symbols_errors = FOUND;
-					return;
-				}
-				/* Generate a direct line string representation of the symbol location*/
-				location_str = generate_direct_line(symbol_location);
-				/* Copy the new string into the value array*/
-				strncpy(actionItem->value, location_str, sizeof(actionItem->value) - 1);
-
-				/* Convert the bit string to an octal representation*/
-				actionItem->octal = bitStringToOctal(location_str);
-
-				/* Free the dynamically allocated string*/
-				free(location_str);
+			/* Encode the symbol location into the item's word*/
+			if (!generate_direct_line(&actionItem->word, symbol_location)) {
+				label_error("second_scan", 416, "assembler_manager.c", "address does not fit in 12 bits", symbol_name);
+				assemblerManager->has_assembler_errors = FOUND;
 			}
 		}
 	}
 
 	/* Process each entry symbol */
 	for (i = 0; i < symbolsManager->ent_used; ++i) {/* handle entry symbols*/
-		char* entlItem = symbolsManager->ent[i]; /*Get the current entry symbol*/
+		const char* entlItem = symbolsManager->ent[i]; /*Get the current entry symbol*/
 
 		/* Find the location of the entry symbol in the symbols table*/
 		int symbol_location = getSymbolLocation(symbolsManager, entlItem);
 
-		/* Generate a direct line string representation of the symbol location*/
-		char* location_str = generate_direct_line(symbol_location);
-
 		/* Add a reference symbol for the entry item to the SymbolsManager*/
 		addReferenceSymbol(symbolsManager, entlItem, symbol_location, NOT_FOUND); /* add new item to ref_symbols*/
-		/* Free the dynamically allocated string*/
-		free(location_str);
 	}
 }
 
+/**
+ * formatObjItems -
+ * Formats items as lines of the object file.
+ *
+ * @param buffer The buffer to write to, it must have room for OBJECT_LINE_MAX_LENGTH characters per item.
+ * @param items The items to write.
+ * @param itemCount The number of items.
+ * @return The number of characters written.
+ */
+static size_t formatObjItems(char* buffer, const Item* items, int itemCount) {
+	size_t used = 0;
+	int i;
+	for (i = 0; i < itemCount; ++i) {
+		used += format_object_line(buffer + used, items[i].location, items[i].word);
+	}
+	return used;
+}
+
 /**
  * printObjToFile -
  * Writes the object code to a file specified by the given file name.
+ * The whole file is formatted into one buffer and written at once.
  *
  * @param file_name The base name of the file to which the object code will be written.
  * @param assemblerManager A pointer to the AssemblerManager that contains the action and data items.
  */
 void printObjToFile(char* file_name, const AssemblerManager* assemblerManager) {
-	int i;
-	int len;
-	char* new_file_path;
-	FILE* file;
-	/*Concatenate extension string to the name of the file*/
-	len = strlen(file_name) + strlen(OBJECTS_FILE_EXTENSION) + 1;
-	new_file_path = malloc(len);
-
-	if (new_file_path == NULL) {
-		log_error("printObjToFile", 447, "assembler_manager.c", "Failed to allocate memory");
-		return;
-	}
+	char* buffer;
+	size_t used;
 
-	strcpy(new_file_path, file_name);
-	strcat(new_file_path, OBJECTS_FILE_EXTENSION);
-	file = fopen(new_file_path, "w");
-	if (file == NULL) {
-		file_error("printObjToFile", 455, "assembler_manager.c", "Failed to open file", new_file_path);
+	buffer = (char*)allocate_memory(assemblerManager->allocator, 2 * DECIMAL_MAX_LENGTH + 2 +
+		(size_t)(assemblerManager->actionItemCount + assemblerManager->dataItemCount) * OBJECT_LINE_MAX_LENGTH);
+	if (buffer == NULL) {
+		log_error("printObjToFile", 467, "assembler_manager.c", "Failed to allocate memory");
 		return;
 	}
 
 	/* Print the first line: IC tab_space DC*/
-	fprintf(file, "%d\t%d\n", assemblerManager->IC, assemblerManager->DC);
-
-	/* Print actionItems*/
-	for (i = 0; i < assemblerManager->actionItemCount; ++i) {
-		fprintf(file, "%d\t%s\n", assemblerManager->actionItems[i].location, assemblerManager->actionItems[i].octal);
-	}
+	used = format_decimal(buffer, assemblerManager->IC);
+	buffer[used++] = '\t';
+	used += format_decimal(buffer + used, assemblerManager->DC);
+	buffer[used++] = '\n';
+
+	/* Print actionItems, then dataItems*/
+	used += formatObjItems(buffer + used, assemblerManager->actionItems, assemblerManager->actionItemCount);
+	used += formatObjItems(buffer + used, assemblerManager->dataItems, assemblerManager->dataItemCount);
+	write_output_file(file_name, OBJECTS_FILE_EXTENSION, buffer, used);
+	release_memory(assemblerManager->allocator, buffer);
+}
 
-	/* Print dataItems*/
-	for (i = 0; i < assemblerManager->dataItemCount; ++i) {
-		fprintf(file, "%d\t%s\n", assemblerManager->dataItems[i].location, assemblerManager->dataItems[i].octal);
+/**
+ * formatReferenceSymbols -
+ * Formats the reference symbols of one type as lines of the .ext or .ent file.
+ *
+ * @param buffer The buffer to write to.
+ * @param manager A pointer to the SymbolsManager that contains the reference symbols.
+ * @param type The type of the symbols to write, true for ext, false for ent.
+ * @return The number of characters written.
+ */
+static size_t formatReferenceSymbols(char* buffer, const SymbolsManager* manager, int type) {
+	size_t used = 0;
+	size_t length;
+	int i;
+	const ReferenceSymbol* ref_symbol;
+	for (i = 0; i < manager->ref_used; ++i) {
+		ref_symbol = &manager->ref_symbols[i];
+		if ((ref_symbol->type != 0) == (type != 0)) {
+			length = strlen(ref_symbol->name);
+			memcpy(buffer + used, ref_symbol->name, length);
+			used += length;
+			buffer[used++] = '\t';
+			used += format_decimal(buffer + used, ref_symbol->location);
+			buffer[used++] = '\n';
+		}
 	}
-
-	fclose(file);
+	return used;
 }
 
 /**
  * printReferenceSymbolsToFile -
  * Writes reference symbols to external and entry files based on their type.
+ * A file is written only if it has symbols, each one is formatted into one buffer and written at once.
  *
  * @param file_name The base name of the file to which the symbols will be written.
  * @param manager A pointer to the SymbolsManager that contains the reference symbols.
  */
 void printReferenceSymbolsToFile(char* file_name, const SymbolsManager* manager) {
-	int len;
-	char* new_file_path;
-	FILE* ent_file = NULL;
-	FILE* ext_file = NULL;
-	int ent_has_values = NOT_FOUND;
+	size_t size = 0;
+	size_t used;
+	char* buffer;
 	int ext_has_values = NOT_FOUND;
+	int ent_has_values = NOT_FOUND;
 	int i;
-	ReferenceSymbol* ref_symbol;
+
+	/* One buffer has room for either file*/
 	for (i = 0; i < manager->ref_used; ++i) {
-		ref_symbol = &manager->ref_symbols[i];
-		if (ref_symbol->type) {
-			if (!ext_has_values) {
-				/*Concatenate extension string to the name of the file*/
-				len = strlen(file_name) + strlen(EXTERNALS_FILE_EXTENSION) + 1;
-				new_file_path = malloc(len);
-
-				if (new_file_path == NULL) {
-					log_error("printReferenceSymbolsToFile", 500, "assembler_manager.c", "Failed to allocate memory");
-					return;
-				}
-
-				strcpy(new_file_path, file_name);
-				strcat(new_file_path, EXTERNALS_FILE_EXTENSION);
-				ext_file = fopen(new_file_path, "w");
-				if (ext_file == NULL) {
-					file_error("printReferenceSymbolsToFile", 508, "assembler_manager.c", "Failed to open file", new_file_path);
-					return;
-				}
-				ext_has_values = 1;
-			}
-			fprintf(ext_file, "%s\t%d\n", ref_symbol->name, ref_symbol->location);
+		size += strlen(manager->ref_symbols[i].name) + DECIMAL_MAX_LENGTH + 2;
+		if (manager->ref_symbols[i].type) {
+			ext_has_values = FOUND;
 		}
 		else {
-			if (!ent_has_values) {
-				/*Concatenate extension string to the name of the file*/
-				len = strlen(file_name) + strlen(ENTRY_FILE_EXTENSION) + 1;
-				new_file_path = malloc(len);
-
-				if (new_file_path == NULL) {
-					log_error("printReferenceSymbolsToFile", 522, "assembler_manager.c", "Failed to allocate memory");
-					return;
-				}
-
-				strcpy(new_file_path, file_name);
-				strcat(new_file_path, ENTRY_FILE_EXTENSION);
-				ent_file = fopen(new_file_path, "w");
-				if (ent_file == NULL) {
-					file_error("printReferenceSymbolsToFile", 530, "assembler_manager.c", "Failed to open file", new_file_path);
-					return;
-				}
-				ent_has_values = 1;
-			}
-			fprintf(ent_file, "%s\t%d\n", ref_symbol->name, ref_symbol->location);
+			ent_has_values = FOUND;
 		}
 	}
+	if (size == 0) {
+		return;
+	}
+
+	buffer = (char*)allocate_memory(manager->allocator, size);
+	if (buffer == NULL) {
+		log_error("printReferenceSymbolsToFile", 543, "assembler_manager.c", "Failed to allocate memory");
+		return;
+	}
 
-	if (ext_file != NULL) {
-		fclose(ext_file);
+	if (ext_has_values) {
+		used = formatReferenceSymbols(buffer, manager, FOUND);
+		write_output_file(file_name, EXTERNALS_FILE_EXTENSION, buffer, used);
 	}
-	if (ent_file != NULL) {
-		fclose(ent_file);
+	if (ent_has_values) {
+		used = formatReferenceSymbols(buffer, manager, NOT_FOUND);
+		write_output_file(file_name, ENTRY_FILE_EXTENSION, buffer, used);
 	}
-}
\ No newline at end of file
+	release_memory(manager->allocator, buffer);
+}
@@ -9,6 +9,7 @@
 #include "symbols_manager.h"
 #include "file_manager.h"
 #include "actions.h"
+#include "line_builder.h"
 #include "data_manager.h"
 #include "first_line_builder.h"
 #include "strings_manager.h"
@@ -20,32 +21,50 @@
 #include "constants.h"
 #include "error_manager.h"
 #include "macro_manager.h"
+#include "memory_manager.h"
+#include "output_manager.h"
+
+#define ITEMS_INITIAL_SIZE 64
+#define FIXUPS_INITIAL_SIZE 32
 
 typedef struct {
 	int location;
-	char* metadata;
-	char value[16];
-	char* octal;
+	const char* metadata; /* The action of a first word, the label of a label operand*/
+	Word word;
 } Item;
 
 
+/* An action item whose word is the location of a label, filled in the second scan*/
+typedef struct {
+	int item; /* Index of the item in actionItems*/
+	Atom symbol; /* The label's atom in the SymbolsManager*/
+} Fixup;
+
+
 typedef struct {
+	Allocator* allocator; /* Owner of the items' memory*/
 	int has_assembler_errors;
 	int IC;
 	int DC;
 	Item* dataItems;
 	int dataItemCount;
+	int dataItemSize;
 	Item* actionItems;
 	int actionItemCount;
+	int actionItemSize;
+	Fixup* fixups;
+	int fixupCount;
+	int fixupSize;
 } AssemblerManager;
 
-AssemblerManager* createAssemblerManager();
-void destroyAssemblerManager(AssemblerManager* manager);
-void first_scan(MacroManager* macroManager, FileManager* fileManager, AssemblerManager* assemblerManager, SymbolsManager* symbolsManager, Action* actions, Registers* registers, Registers_2* registers_2);
-void processActionLine(Action* actions, char** line, AssemblerManager* assemblerManager, Registers* registers, Registers_2* registers_2);
-void processDataLine(char** line, AssemblerManager* assemblerManager);
-void addDataItem(AssemblerManager* manager, int location, const char* value);
-void addActionItem(AssemblerManager* manager, char* metadata, int location, const char* value);
+AssemblerManager* createAssemblerManager(Allocator* allocator);
+void first_scan(MacroManager* macroManager, FileManager* fileManager, AssemblerManager* assemblerManager, SymbolsManager* symbolsManager, Registers* registers, Registers_2* registers_2);
+void first_scan_line(char** line, AssemblerManager* assemblerManager, SymbolsManager* symbolsManager, Registers* registers, Registers_2* registers_2);
+void processActionLine(const ParsedLine* parsed, AssemblerManager* assemblerManager);
+void processDataLine(const ParsedLine* parsed, AssemblerManager* assemblerManager);
+void addDataItem(AssemblerManager* manager, int location, Word word);
+Word* addActionItem(AssemblerManager* manager, const char* metadata);
+void addFixup(AssemblerManager* manager, Atom symbol);
 void printDataItems(const AssemblerManager* manager);
 void printActionItems(const AssemblerManager* manager);
 void updateLocationDataSymbols(const SymbolsManager* symbolsManager, const AssemblerManager* manager);
@@ -0,0 +1,154 @@
+#include "atom_manager.h"
+
+/**
+ * init_atom_table -
+ * Initializes an empty AtomTable.
+ *
+ * @param table Pointer to the AtomTable structure to be initialized.
+ * @param allocator The allocator that owns the names and the tables.
+ */
+void init_atom_table(AtomTable* table, Allocator* allocator) {
+	table->allocator = allocator;
+	table->names = NULL;
+	table->count = 0;
+	table->size = 0;
+	table->slots = NULL;
+	table->slot_count = 0;
+}
+
+/**
+ * find_atom_slot -
+ * Finds the slot of a name in the hash table.
+ *
+ * @param table Pointer to the AtomTable structure, its hash table must not be empty.
+ * @param name The characters of the name, they do not have to be null-terminated.
+ * @param length The number of characters in the name.
+ * @param hash The hash of the name.
+ * @return The slot holding the name's atom, or the empty slot where it would be added.
+ */
+static unsigned long find_atom_slot(const AtomTable* table, const char* name, size_t length, unsigned long hash) {
+	unsigned long mask = (unsigned long)table->slot_count - 1;
+	unsigned long slot = hash & mask;
+	while (table->slots[slot].atom != NO_ATOM) {
+		/* Only a name with the same hash can be the same name*/
+		if (table->slots[slot].hash == hash) {
+			const char* other = table->names[table->slots[slot].atom];
+			if (strncmp(other, name, length) == 0 && other[length] == '\0') {
+				break;
+			}
+		}
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+/**
+ * grow_atom_slots -
+ * Doubles the hash table and places every atom in it again.
+ *
+ * @param table Pointer to the AtomTable structure.
+ * @return FOUND if the table was grown, NOT_FOUND if memory allocation failed.
+ */
+static int grow_atom_slots(AtomTable* table) {
+	int i;
+	unsigned long mask;
+	int new_count = table->slot_count ? table->slot_count * 2 : ATOMS_INITIAL_SIZE * 2;
+	AtomSlot* new_slots = (AtomSlot*)allocate_memory(table->allocator, new_count * sizeof(AtomSlot));
+	if (new_slots == NULL) {
+		log_error("grow_atom_slots", 57, "atom_manager.c", "Memory allocation failed");
+		return NOT_FOUND;
+	}
+	for (i = 0; i < new_count; i++) {
+		new_slots[i].atom = NO_ATOM;
+	}
+
+	/* The names are all different, each one goes to the first empty slot from its home slot*/
+	mask = (unsigned long)new_count - 1;
+	for (i = 0; i < table->slot_count; i++) {
+		if (table->slots[i].atom != NO_ATOM) {
+			unsigned long slot = table->slots[i].hash & mask;
+			while (new_slots[slot].atom != NO_ATOM) slot = (slot + 1) & mask;
+			new_slots[slot] = table->slots[i];
+		}
+	}
+	table->slots = new_slots;
+	table->slot_count = new_count;
+	return FOUND;
+}
+
+/**
+ * intern_atom -
+ * Returns the atom of a name, storing the name the first time it is seen.
+ *
+ * @param table Pointer to the AtomTable structure.
+ * @param name The characters of the name, they do not have to be null-terminated.
+ * @param length The number of characters in the name.
+ * @return The atom of the name, or NO_ATOM if memory allocation failed.
+ */
+Atom intern_atom(AtomTable* table, const char* name, size_t length) {
+	unsigned long slot;
+	unsigned long hash = hash_string(name, length);
+	char* copy;
+
+	/* Keep the hash table at most half full*/
+	if ((table->count + 1) * 2 > table->slot_count && !grow_atom_slots(table)) {
+		return NO_ATOM;
+	}
+	slot = find_atom_slot(table, name, length, hash);
+	if (table->slots[slot].atom != NO_ATOM) {
+		return table->slots[slot].atom;
+	}
+
+	if (table->count == table->size) {
+		int new_size = table->size ? table->size * 2 : ATOMS_INITIAL_SIZE;
+		const char** new_names = (const char**)resize_memory(table->allocator, (void*)table->names, new_size * sizeof(char*));
+		if (new_names == NULL) {
+			log_error("intern_atom", 103, "atom_manager.c", "Memory allocation failed");
+			return NO_ATOM;
+		}
+		table->names = new_names;
+		table->size = new_size;
+	}
+	copy = (char*)allocate_memory(table->allocator, length + 1);
+	if (copy == NULL) {
+		log_error("intern_atom", 111, "atom_manager.c", "Memory allocation failed");
+		return NO_ATOM;
+	}
+	memcpy(copy, name, length);
+	copy[length] = '\0';
+
+	table->names[table->count] = copy;
+	table->slots[slot].hash = hash;
+	table->slots[slot].atom = table->count;
+	return table->count++;
+}
+
+/**
+ * find_atom -
+ * Returns the atom of a name without storing it.
+ *
+ * @param table Pointer to the AtomTable structure.
+ * @param name The characters of the name, they do not have to be null-terminated.
+ * @param length The number of characters in the name.
+ * @return The atom of the name, or NO_ATOM if the name was never interned.
+ */
+Atom find_atom(const AtomTable* table, const char* name, size_t length) {
+	unsigned long slot;
+	if (table->slot_count == 0) {
+		return NO_ATOM;
+	}
+	slot = find_atom_slot(table, name, length, hash_string(name, length));
+	return table->slots[slot].atom;
+}
+
+/**
+ * atom_name -
+ * Returns the name of an atom.
+ *
+ * @param table Pointer to the AtomTable structure.
+ * @param atom The atom.
+ * @return The null-terminated name, owned by the table.
+ */
+const char* atom_name(const AtomTable* table, Atom atom) {
+	return table->names[atom];
+}
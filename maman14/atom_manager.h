@@ -0,0 +1,41 @@
+#ifndef ATOM_MANAGER_H
+#define ATOM_MANAGER_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "constants.h"
+#include "error_manager.h"
+#include "memory_manager.h"
+#include "strings_manager.h"
+
+#define ATOMS_INITIAL_SIZE 16
+#define NO_ATOM -1
+
+/* An atom is the number of an interned name: two names are equal exactly when their atoms are*/
+typedef int Atom;
+
+/* A slot of the hash table keeps the hash of its name, so probing past other names
+ * compares numbers in the table instead of reading their characters*/
+typedef struct {
+	unsigned long hash;
+	Atom atom;           /* NO_ATOM marks an empty slot*/
+} AtomSlot;
+
+/* Interns names: every name is stored once and numbered in the order it was first seen*/
+typedef struct {
+	Allocator* allocator; /* Owner of the names and of the tables*/
+	const char** names;  /* The name of each atom*/
+	int count;
+	int size;
+	AtomSlot* slots;     /* Open addressing hash table with linear probing*/
+	int slot_count;      /* Number of slots, always a power of two*/
+} AtomTable;
+
+void init_atom_table(AtomTable* table, Allocator* allocator);
+Atom intern_atom(AtomTable* table, const char* name, size_t length);
+Atom find_atom(const AtomTable* table, const char* name, size_t length);
+const char* atom_name(const AtomTable* table, Atom atom);
+
+#endif /* ATOM_MANAGER_H*/
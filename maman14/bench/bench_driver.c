@@ -0,0 +1,1616 @@
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+#include "constants.h"
+#include "error_manager.h"
+#include "memory_manager.h"
+#include "source_manager.h"
+#include "file_manager.h"
+#include "macro_manager.h"
+#include "assembler_manager.h"
+#include "symbols_manager.h"
+#include "operands.h"
+#include "number_manager.h"
+#include "first_line_builder.h"
+#include "immediate_builder.h"
+#include "direct_builder.h"
+#include "register_builder.h"
+#include "pipeline_manager.h"
+#include "library_manager.h"
+
+/* The phases of assembling a file, timed one by one in the order the assembler runs them*/
+typedef enum BenchPhase {
+	BenchInputPhase,      /* input_process: tokenizing and macro expansion*/
+	BenchFirstScanPhase,  /* first_scan, after input_process: the assembler's pipeline may overlap them*/
+	BenchPostMacroPhase,  /* The .am file*/
+	BenchSecondScanPhase, /* Data locations and second_scan*/
+	BenchOutputPhase,     /* The .ob, .ext and .ent files*/
+	PHASE_COUNT
+} BenchPhase;
+
+/* With --scaling, a file twice the size may take at most this many times twice the time*/
+#define SCALING_BOUND 1.5
+/* With --scaling, a file is assembled again and again until this many seconds are measured, so the
+ * time of a small file is not the timer's noise*/
+#define SCALING_MIN_SECONDS 0.05
+
+/* The ways --differential assembles the files, the first one is the reference the others must match*/
+typedef enum PathKind {
+	AssemblerPath,   /* The assembler program, run once on all the files with the path's options*/
+	SequentialPath,  /* input_process then first_scan, one after the other*/
+	PipelinePath,    /* run_first_pass: the first scan takes the lines while the macros are expanded*/
+	LibraryPath      /* assemble_source on the file's text, its words written by printObjToFile*/
+} PathKind;
+
+/* The files a path writes for each input file*/
+#define PATH_WRITES_AM 1
+#define PATH_WRITES_OBJECT 2     /* The .ob, .ext and .ent files*/
+#define PATH_WRITES_ERRORS 4     /* The errors of every file, in the order of the files*/
+#define PATH_WRITES_ALL (PATH_WRITES_AM | PATH_WRITES_OBJECT | PATH_WRITES_ERRORS)
+
+typedef struct {
+	const char* name;       /* Also the name of the path's directory*/
+	PathKind kind;
+	AllocatorKind allocator;
+	const char* options;    /* The options of an AssemblerPath*/
+	int writes;             /* PATH_WRITES_* bits*/
+} DifferentialPath;
+
+static const DifferentialPath differential_paths[] = {
+	{ "assembler", AssemblerPath, DEFAULT_ALLOCATOR, "", PATH_WRITES_ALL },
+	{ "assembler-system", AssemblerPath, SystemAllocator, "--allocator=system", PATH_WRITES_ALL },
+	{ "assembler-counting", AssemblerPath, CountingAllocator, "--allocator=counting", PATH_WRITES_ALL },
+	{ "assembler-j4", AssemblerPath, DEFAULT_ALLOCATOR, "-j 4", PATH_WRITES_ALL },
+	{ "assembler-E", AssemblerPath, DEFAULT_ALLOCATOR, "-E", PATH_WRITES_AM },
+	{ "sequential-system", SequentialPath, SystemAllocator, NULL, PATH_WRITES_ALL },
+	{ "sequential-bump", SequentialPath, BumpAllocator, NULL, PATH_WRITES_ALL },
+	{ "pipeline-system", PipelinePath, SystemAllocator, NULL, PATH_WRITES_ALL },
+	{ "pipeline-bump", PipelinePath, BumpAllocator, NULL, PATH_WRITES_ALL },
+	{ "pipeline-counting", PipelinePath, CountingAllocator, NULL, PATH_WRITES_ALL },
+	{ "library", LibraryPath, BumpAllocator, NULL, PATH_WRITES_OBJECT | PATH_WRITES_ERRORS }
+};
+#define DIFFERENTIAL_PATH_COUNT ((int)(sizeof(differential_paths) / sizeof(differential_paths[0])))
+
+/* The files compared for each input file, and the PATH_WRITES_* bit of the paths that write them*/
+static const char* output_extensions[] = {
+	POST_MACRO_FILE_EXTENSION, OBJECTS_FILE_EXTENSION, EXTERNALS_FILE_EXTENSION, ENTRY_FILE_EXTENSION
+};
+static const int output_writers[] = {
+	PATH_WRITES_AM, PATH_WRITES_OBJECT, PATH_WRITES_OBJECT, PATH_WRITES_OBJECT
+};
+#define OUTPUT_EXTENSION_COUNT ((int)(sizeof(output_extensions) / sizeof(output_extensions[0])))
+
+#define ERRORS_FILE_NAME "errors.txt" /* The errors a path printed, in its directory*/
+#define GOLDEN_ERRORS_EXTENSION ".errors" /* The errors of a --golden input, next to it, none if it has no errors*/
+#define ERROR_LOCATION_START "Error in function " /* The start of an error line, up to where its message starts*/
+#define ERROR_LOCATION_FILE " in file "
+#define DIFFERENTIAL_DIRECTORY "bench/differential" /* Where the paths' directories are, unless --work-dir is given*/
+#define ASSEMBLER_PROGRAM "./assembler" /* The assembler the AssemblerPaths run, unless --assembler is given*/
+
+static const char* phase_names[PHASE_COUNT] = {
+	"input_process", "first_scan", "post_macro", "second_scan", "output"
+};
+
+/* What a phase took over all the files and iterations*/
+typedef struct {
+	double seconds;
+	unsigned long allocations;
+	long rss_growth; /* How much the phase raised the peak resident set size of the process, in KB*/
+} PhaseStats;
+
+/* Where the counters were when a phase started*/
+typedef struct {
+	double seconds;
+	unsigned long allocations;
+	long peak_rss;
+} PhaseStart;
+
+/* Counted by the wrappers of the allocator, the makefile links them with --wrap*/
+static unsigned long allocation_count = 0;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size) {
+	allocation_count++;
+	return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+	allocation_count++;
+	return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+	allocation_count++;
+	return __real_realloc(ptr, size);
+}
+
+/**
+ * now_seconds -
+ * Gives a monotonic time.
+ *
+ * @return The time in seconds.
+ */
+static double now_seconds(void) {
+	struct timespec time;
+	clock_gettime(CLOCK_MONOTONIC, &time);
+	return (double)time.tv_sec + (double)time.tv_nsec / 1e9;
+}
+
+/**
+ * peak_rss -
+ * Gives the peak resident set size of the process.
+ *
+ * @return The peak in KB.
+ */
+static long peak_rss(void) {
+	struct rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+	return (long)(usage.ru_maxrss / 1024);
+#else
+	return (long)usage.ru_maxrss;
+#endif
+}
+
+/**
+ * open_input_source -
+ * Opens the .as file of an input file.
+ *
+ * @param source Pointer to the SourceManager that receives the file.
+ * @param file_name The base name of the input file, without its extension.
+ * @return FOUND if the file was opened, NOT_FOUND otherwise.
+ */
+static int open_input_source(SourceManager* source, const char* file_name) {
+	char* file_path = (char*)malloc(strlen(file_name) + strlen(INPUT_FILE_EXTENSION) + 1);
+	int result;
+
+	if (file_path == NULL) {
+		return NOT_FOUND;
+	}
+	strcpy(file_path, file_name);
+	strcat(file_path, INPUT_FILE_EXTENSION);
+	result = open_source_manager(source, file_path);
+	free(file_path);
+	return result;
+}
+
+/**
+ * count_source_lines -
+ * Counts the lines of an input file.
+ *
+ * @param file_name The base name of the input file, without its extension.
+ * @param bytes Set to the size of the file, if it is not NULL.
+ * @return The number of lines, or -1 if the file can't be read.
+ */
+static long count_source_lines(const char* file_name, long* bytes) {
+	SourceManager source;
+	const char* position;
+	const char* end;
+	long lines = 0;
+
+	if (!open_input_source(&source, file_name)) {
+		return -1;
+	}
+
+	if (bytes != NULL) {
+		*bytes = source.length;
+	}
+	position = source.data;
+	end = source.data + source.length;
+	while (position < end && (position = (const char*)memchr(position, '\n', (size_t)(end - position))) != NULL) {
+		position++;
+		lines++;
+	}
+	/* The last line may have no newline*/
+	if (source.length > 0 && source.data[source.length - 1] != '\n') {
+		lines++;
+	}
+	close_source_manager(&source);
+	return lines;
+}
+
+/**
+ * begin_bench_phase -
+ * Reads the counters a phase is measured from.
+ *
+ * @param start Receives the counters.
+ */
+static void begin_bench_phase(PhaseStart* start) {
+	start->allocations = allocation_count;
+	start->peak_rss = peak_rss();
+	start->seconds = now_seconds();
+}
+
+/**
+ * end_bench_phase -
+ * Adds what a phase took since it started to its stats.
+ * The peak resident set size only grows, so a phase is charged with the growth it caused:
+ * a phase that reuses memory an earlier one freed shows none.
+ *
+ * @param stats The stats of the phase.
+ * @param start The counters when the phase started.
+ */
+static void end_bench_phase(PhaseStats* stats, const PhaseStart* start) {
+	stats->seconds += now_seconds() - start->seconds;
+	stats->allocations += allocation_count - start->allocations;
+	stats->rss_growth += peak_rss() - start->peak_rss;
+}
+
+/**
+ * bench_file -
+ * Assembles a file the way the assembler does, one phase after the other, and times each phase.
+ * Unlike the assembler, input_process and first_scan never overlap, so each is timed alone.
+ *
+ * @param file_name The base name of the input file, without its extension.
+ * @param format How the .am file is written.
+ * @param kind Where the memory of the file is taken from.
+ * @param registers The registers' names.
+ * @param registers_2 The indirect registers' names.
+ * @param stats The stats of the phases, updated.
+ * @return FOUND if the file was assembled without errors, NOT_FOUND otherwise.
+ */
+static int bench_file(char* file_name, PostMacroFormat format, AllocatorKind kind, Registers* registers, Registers_2* registers_2, PhaseStats* stats) {
+	FileManager fileManager;
+	MacroManager macroManager;
+	Arena arena;
+	Arena scan_arena;
+	Allocator allocator;
+	Allocator scan_allocator;
+	AssemblerManager* assemblerManager;
+	SymbolsManager* symbolsManager;
+	PhaseStart start;
+	int result = NOT_FOUND;
+
+	init_arena(&arena);
+	init_arena(&scan_arena);
+	init_allocator(&allocator, kind, &arena);
+	init_allocator(&scan_allocator, kind, &scan_arena);
+
+	begin_bench_phase(&start);
+	initialize_file_manager(&fileManager, &allocator);
+	init_macro_manager(&macroManager, &allocator);
+	if (input_process(&fileManager, &macroManager, file_name)) {
+		end_bench_phase(&stats[BenchInputPhase], &start);
+
+		begin_bench_phase(&start);
+		assemblerManager = createAssemblerManager(&scan_allocator);
+		symbolsManager = createSymbolsManager(&scan_allocator);
+		if (assemblerManager != NULL && symbolsManager != NULL) {
+			first_scan(&macroManager, &fileManager, assemblerManager, symbolsManager, registers, registers_2);
+			end_bench_phase(&stats[BenchFirstScanPhase], &start);
+
+			/* As in the assembler, the .am file is written before the second scan, even if the scans find errors*/
+			begin_bench_phase(&start);
+			result = printPostMacroToFile(file_name, &fileManager, format);
+			end_bench_phase(&stats[BenchPostMacroPhase], &start);
+
+			if (result) {
+				begin_bench_phase(&start);
+				updateLocationDataSymbols(symbolsManager, assemblerManager);
+				updateDataItemsLocation(assemblerManager);
+				second_scan(assemblerManager, symbolsManager);
+				end_bench_phase(&stats[BenchSecondScanPhase], &start);
+
+				result = NOT_FOUND;
+				if (assemblerManager->has_assembler_errors == NOT_FOUND && symbolsManager->has_symbols_errors == NOT_FOUND) {
+					begin_bench_phase(&start);
+					printObjToFile(file_name, assemblerManager);
+					printReferenceSymbolsToFile(file_name, symbolsManager);
+					end_bench_phase(&stats[BenchOutputPhase], &start);
+					result = FOUND;
+				}
+			}
+		}
+	}
+
+	release_allocator(&scan_allocator);
+	release_allocator(&allocator);
+	return result;
+}
+
+/**
+ * base_name -
+ * Gives the name of a file without its directories.
+ *
+ * @param file_name The name of the file.
+ * @return The part of file_name after its last '/'.
+ */
+static const char* base_name(const char* file_name) {
+	const char* slash = strrchr(file_name, '/');
+	return slash != NULL ? slash + 1 : file_name;
+}
+
+/**
+ * has_object_file -
+ * Checks that the .ob file of an input file was written, or removes it before it is written again.
+ *
+ * @param file_name The base name of the input file, without its extension.
+ * @param remove_it FOUND to remove the file, NOT_FOUND to check it.
+ * @return FOUND if the .ob file exists and is not empty, NOT_FOUND otherwise or if it was removed.
+ */
+static int has_object_file(const char* file_name, int remove_it) {
+	char* file_path = (char*)malloc(strlen(file_name) + strlen(OBJECTS_FILE_EXTENSION) + 1);
+	FILE* file;
+	int result = NOT_FOUND;
+
+	if (file_path == NULL) {
+		return NOT_FOUND;
+	}
+	strcpy(file_path, file_name);
+	strcat(file_path, OBJECTS_FILE_EXTENSION);
+	if (remove_it) {
+		remove(file_path);
+	}
+	else if ((file = fopen(file_path, "r")) != NULL) {
+		result = fgetc(file) != EOF ? FOUND : NOT_FOUND;
+		fclose(file);
+	}
+	free(file_path);
+	return result;
+}
+
+/**
+ * time_file -
+ * Times the assembly of a file. The file is assembled again and again until min_seconds are
+ * measured, and the time of one assembly of them is given. Its errors are kept in a log, the
+ * first one is printed if the file fails to assemble.
+ *
+ * @param file_name The base name of the input file, without its extension.
+ * @param format How the .am file is written.
+ * @param kind Where the memory of the file is taken from.
+ * @param min_seconds The shortest time that is measured.
+ * @param registers The registers' names.
+ * @param registers_2 The indirect registers' names.
+ * @return The time of one assembly, in seconds, or -1 if it failed to assemble.
+ */
+static double time_file(char* file_name, PostMacroFormat format, AllocatorKind kind, double min_seconds,
+	Registers* registers, Registers_2* registers_2) {
+	PhaseStats stats[PHASE_COUNT];
+	ErrorLog errors;
+	double seconds = 0;
+	long repeats;
+	int phase, failed = NOT_FOUND;
+
+	init_error_log(&errors);
+	set_error_log(&errors);
+	/* The phases add up their times over the repeats*/
+	memset(stats, 0, sizeof(stats));
+	for (repeats = 0; (repeats == 0 || seconds < min_seconds) && !failed; repeats++) {
+		if (!bench_file(file_name, format, kind, registers, registers_2, stats)) {
+			size_t length = 0;
+			while (length < errors.length && errors.text[length] != '\n') {
+				length++;
+			}
+			printf("%s failed to assemble: %.*s\n", base_name(file_name), (int)length, errors.text != NULL ? errors.text : "");
+			failed = FOUND;
+		}
+		seconds = 0;
+		for (phase = 0; phase < PHASE_COUNT; phase++) {
+			seconds += stats[phase].seconds;
+		}
+		errors.length = 0;
+	}
+	set_error_log(NULL);
+	free(errors.text);
+	return failed ? -1 : seconds / repeats;
+}
+
+/**
+ * check_scaling -
+ * Assembles pairs of files, a small one and a large one of the same kind, and checks that
+ * the time grows about as the size does. A path that is quadratic or worse takes about twice
+ * as long as the size alone explains, so it goes over the bound. A file that has errors or
+ * doesn't get its .ob file fails the check, its time would be of a partial assembly.
+ *
+ * @param files The base names of the files, the small file of each pair before the large one.
+ * @param file_count The number of files.
+ * @param bound How many times the size ratio the time ratio may be.
+ * @param format How the .am file is written.
+ * @param kind Where the memory of the files is taken from.
+ * @param iterations How many times each file is timed, the shortest time is kept. Each time is
+ * of at least SCALING_MIN_SECONDS of assemblies, and the two files of a pair take turns so a
+ * slow moment of the machine falls on both.
+ * @param registers The registers' names.
+ * @param registers_2 The indirect registers' names.
+ * @return OK if every pair assembles and is within the bound, !OK otherwise.
+ */
+static int check_scaling(char** files, int file_count, double bound, PostMacroFormat format, AllocatorKind kind,
+	long iterations, Registers* registers, Registers_2* registers_2) {
+	int i, failed = 0;
+	long iteration;
+
+	if (file_count % 2 != 0) {
+		fprintf(stderr, "--scaling takes pairs of files, a small one then a large one\n");
+		return !OK;
+	}
+
+	printf("%-20s %-20s %10s %10s %10s %10s\n", "small", "large", "seconds", "size x", "time x", "result");
+	for (i = 0; i < file_count; i += 2) {
+		long small_bytes, large_bytes;
+		double small_seconds = -1, large_seconds = -1, small_time, large_time, size_ratio, time_ratio;
+
+		count_source_lines(files[i], &small_bytes);
+		count_source_lines(files[i + 1], &large_bytes);
+		has_object_file(files[i], FOUND);
+		has_object_file(files[i + 1], FOUND);
+		for (iteration = 0; iteration < iterations; iteration++) {
+			small_time = time_file(files[i], format, kind, SCALING_MIN_SECONDS, registers, registers_2);
+			large_time = time_file(files[i + 1], format, kind, SCALING_MIN_SECONDS, registers, registers_2);
+			if (small_time < 0 || large_time < 0) {
+				small_seconds = large_seconds = -1;
+				break;
+			}
+			if (small_seconds < 0 || small_time < small_seconds) {
+				small_seconds = small_time;
+			}
+			if (large_seconds < 0 || large_time < large_seconds) {
+				large_seconds = large_time;
+			}
+		}
+		if (small_seconds < 0 || large_seconds < 0 || !has_object_file(files[i], NOT_FOUND) || !has_object_file(files[i + 1], NOT_FOUND)) {
+			printf("%-20s %-20s %10s %10s %10s %10s\n", base_name(files[i]), base_name(files[i + 1]), "", "", "", "FAILED");
+			failed++;
+			continue;
+		}
+		size_ratio = small_bytes > 0 ? (double)large_bytes / small_bytes : 0.0;
+		time_ratio = small_seconds > 0 ? large_seconds / small_seconds : 0.0;
+
+		printf("%-20s %-20s %10.4f %10.2f %10.2f %10s\n", base_name(files[i]), base_name(files[i + 1]), large_seconds, size_ratio, time_ratio,
+			time_ratio <= bound * size_ratio ? "ok" : "TOO SLOW");
+		if (time_ratio > bound * size_ratio) {
+			failed++;
+		}
+	}
+	if (failed > 0) {
+		printf("%d of %d pairs failed to assemble or grew faster than %.2f times their size\n", failed, file_count / 2, bound);
+		return !OK;
+	}
+	return OK;
+}
+
+/* With --formatting, every word is formatted, WORD_MASK + 1 of them*/
+#define FORMATTING_WORD_COUNT (WORD_MASK + 1)
+
+/**
+ * bitStringToOctal -
+ * The conversion of a word to octal that printObjToFile used before words were integers, kept
+ * to compare format_object_line with. The word is a string of WORD_SIZE_IN_BITS '0' and '1' characters.
+ *
+ * @param bitString The word's bits, the most significant first.
+ * @return A new string of the 5 octal digits of the word, or NULL if memory allocation fails.
+ */
+static char* bitStringToOctal(const char* bitString) {
+	unsigned int decimal = 0;
+	unsigned int octal = 0, place = 1;
+	char* octalString = (char*)malloc(6 * sizeof(char)); /* 5 chars + 1 null terminator*/
+	int i;
+
+	if (octalString == NULL) {
+		return NULL;  /* Return NULL if memory allocation fails*/
+	}
+
+	/* Convert the bit string to a decimal number*/
+	for (i = 0; i < WORD_SIZE_IN_BITS; i++) {
+		if (bitString[i] == '1') {
+			decimal += (1U << ((WORD_SIZE_IN_BITS-1) - i));
+		}
+	}
+
+	/* Convert the decimal number to octal*/
+	while (decimal > 0) {
+		octal += (decimal % 8) * place;
+		decimal /= 8;
+		place *= 10;
+	}
+
+	/* Convert the octal number to a string*/
+	for (i = 4; i >= 0; i--) {
+		octalString[i] = '0' + (octal % 10);
+		octal /= 10;
+	}
+	octalString[5] = '\0';
+
+	return octalString;
+}
+
+/**
+ * check_formatting -
+ * Formats every word as a line of the .ob file, with format_object_line and the way it was done
+ * before, with bitStringToOctal and fprintf's "%d\t%s\n" (into memory here, so no I/O is timed).
+ * Checks that both give the same text and prints the time and the allocations of each.
+ *
+ * @param iterations How many times the words are formatted, the shortest time is kept.
+ * @return OK if both give the same text, !OK otherwise.
+ */
+static int check_formatting(long iterations) {
+	char (*bit_strings)[WORD_SIZE_IN_BITS + 1];
+	char* expected;
+	char* text;
+	char* octal;
+	size_t expected_length = 0, length = 0;
+	double best_old = -1, best_new = -1, start;
+	unsigned long old_allocations = 0, new_allocations = 0, allocations;
+	long iteration;
+	int i, bit, result = OK;
+
+	bit_strings = malloc(FORMATTING_WORD_COUNT * sizeof(*bit_strings));
+	expected = (char*)malloc(FORMATTING_WORD_COUNT * OBJECT_LINE_MAX_LENGTH);
+	text = (char*)malloc(FORMATTING_WORD_COUNT * OBJECT_LINE_MAX_LENGTH);
+	if (bit_strings == NULL || expected == NULL || text == NULL) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		free(bit_strings);
+		free(expected);
+		free(text);
+		return !OK;
+	}
+
+	/* The words the way they were kept before, as strings of bits*/
+	for (i = 0; i < FORMATTING_WORD_COUNT; i++) {
+		for (bit = 0; bit < WORD_SIZE_IN_BITS; bit++) {
+			bit_strings[i][bit] = (i >> (WORD_SIZE_IN_BITS - 1 - bit)) & 1 ? '1' : '0';
+		}
+		bit_strings[i][WORD_SIZE_IN_BITS] = '\0';
+	}
+
+	for (iteration = 0; iteration < iterations; iteration++) {
+		allocations = allocation_count;
+		start = now_seconds();
+		expected_length = 0;
+		for (i = 0; i < FORMATTING_WORD_COUNT; i++) {
+			octal = bitStringToOctal(bit_strings[i]);
+			if (octal == NULL) {
+				break;
+			}
+			expected_length += sprintf(expected + expected_length, "%d\t%s\n", FIRST_MEMORY_PLACE + i, octal);
+			free(octal);
+		}
+		start = now_seconds() - start;
+		if (best_old < 0 || start < best_old) {
+			best_old = start;
+		}
+		old_allocations = allocation_count - allocations;
+
+		allocations = allocation_count;
+		start = now_seconds();
+		length = 0;
+		for (i = 0; i < FORMATTING_WORD_COUNT; i++) {
+			length += format_object_line(text + length, FIRST_MEMORY_PLACE + i, (Word)i);
+		}
+		start = now_seconds() - start;
+		if (best_new < 0 || start < best_new) {
+			best_new = start;
+		}
+		new_allocations = allocation_count - allocations;
+	}
+
+	printf("%d words, %ld iterations\n", FORMATTING_WORD_COUNT, iterations);
+	printf("%-20s %10s %14s %14s\n", "formatter", "seconds", "ns/word", "allocations");
+	printf("%-20s %10.4f %14.1f %14lu\n", "bitStringToOctal", best_old, best_old * 1e9 / FORMATTING_WORD_COUNT, old_allocations);
+	printf("%-20s %10.4f %14.1f %14lu\n", "format_object_line", best_new, best_new * 1e9 / FORMATTING_WORD_COUNT, new_allocations);
+	printf("speedup %.2f\n", best_new > 0 ? best_old / best_new : 0.0);
+	if (length != expected_length || memcmp(expected, text, length) != 0) {
+		printf("format_object_line writes other lines than bitStringToOctal\n");
+		result = !OK;
+	}
+
+	free(bit_strings);
+	free(expected);
+	free(text);
+	return result;
+}
+
+/* The actions --encoding encodes the first word of*/
+static const char* encoding_actions[] = {
+	"mov", "cmp", "add", "sub", "lea", "clr", "not", "inc",
+	"dec", "jmp", "bne", "red", "prn", "jsr", "rts", "stop"
+};
+#define ENCODING_ACTION_COUNT ((int)(sizeof(encoding_actions) / sizeof(encoding_actions[0])))
+
+/* The ADDRESSING_* bit of each addressing mode, in the order of the mode numbers*/
+static const int encoding_modes[] = {
+	ADDRESSING_IMMEDIATE, ADDRESSING_DIRECT, ADDRESSING_INDIRECT_REGISTER, ADDRESSING_DIRECT_REGISTER
+};
+#define ENCODING_MODE_COUNT ((int)(sizeof(encoding_modes) / sizeof(encoding_modes[0])))
+
+#define ENCODING_IMMEDIATE_MIN -2048 /* The range of a 12-bit two's complement value*/
+#define ENCODING_IMMEDIATE_MAX 2047
+#define ENCODING_DIRECT_MAX 4095     /* The largest 12-bit address*/
+
+/**
+ * encode_words -
+ * Encodes every word the instruction encoders can make once: the first word of every action with
+ * every pair of addressing modes, every immediate value, every direct address and every pair of registers.
+ *
+ * @param words Set to the number of words encoded.
+ * @return FOUND if every word was encoded, NOT_FOUND otherwise.
+ */
+static int encode_words(long* words) {
+	ParsedLine parsed;
+	Word word;
+	int i, source, dest, value, result = FOUND;
+
+	memset(&parsed, 0, sizeof(parsed));
+	for (i = 0; i < ENCODING_ACTION_COUNT; i++) {
+		parsed.action = find_action(encoding_actions[i]);
+		if (parsed.action == NULL) {
+			return NOT_FOUND;
+		}
+		parsed.operand_count = parsed.action->operand_count;
+		for (source = 0; source < ENCODING_MODE_COUNT; source++) {
+			for (dest = 0; dest < ENCODING_MODE_COUNT; dest++) {
+				parsed.operands[0].mode = encoding_modes[source];
+				parsed.operands[1].mode = encoding_modes[dest];
+				result &= process_first_line(&word, &parsed);
+				(*words)++;
+			}
+		}
+	}
+	for (value = ENCODING_IMMEDIATE_MIN; value <= ENCODING_IMMEDIATE_MAX; value++) {
+		result &= generate_immediate_line(&word, value);
+		(*words)++;
+	}
+	for (value = 0; value <= ENCODING_DIRECT_MAX; value++) {
+		result &= generate_direct_line(&word, value);
+		(*words)++;
+	}
+	for (source = NO_REGISTER; source < NUM_OF_REGISTERS; source++) {
+		for (dest = NO_REGISTER; dest < NUM_OF_REGISTERS; dest++) {
+			result &= generate_register_line(&word, source, dest);
+			(*words)++;
+		}
+	}
+	return result;
+}
+
+/**
+ * check_encoding -
+ * Times the instruction encoders (the first word, immediate, direct and register builders)
+ * and checks that they don't allocate: they write into the word slot they are given.
+ *
+ * @param iterations How many times the words are encoded, the shortest time is kept.
+ * @return OK if every word was encoded without an allocation, !OK otherwise.
+ */
+static int check_encoding(long iterations) {
+	double best = -1, start;
+	unsigned long allocations = allocation_count;
+	long iteration, words = 0;
+	int encoded = FOUND;
+
+	for (iteration = 0; iteration < iterations; iteration++) {
+		words = 0;
+		start = now_seconds();
+		encoded &= encode_words(&words);
+		start = now_seconds() - start;
+		if (best < 0 || start < best) {
+			best = start;
+		}
+	}
+	allocations = allocation_count - allocations;
+
+	printf("%ld words, %ld iterations\n", words, iterations);
+	printf("%-20s %10s %14s %14s\n", "encoders", "seconds", "ns/word", "allocations");
+	printf("%-20s %10.4f %14.1f %14lu\n", "first/imm/dir/reg", best, words > 0 ? best * 1e9 / words : 0.0, allocations);
+	if (!encoded) {
+		printf("An encoder failed to encode a word that fits\n");
+		return !OK;
+	}
+	if (allocations > 0) {
+		printf("The encoders allocated %lu times, they must only write the slot they are given\n", allocations);
+		return !OK;
+	}
+	return OK;
+}
+
+/* The ways --splitting splits the lines of a source*/
+static const char* splitting_names[] = { "sse2-blocks", "byte-by-byte" };
+#define SPLITTING_COUNT 2
+
+/**
+ * compare_splitting -
+ * Splits every line of a file both ways and checks that they give the same tokens.
+ *
+ * @param file_name The base name of the input file, without its extension.
+ * @return FOUND if every line gives the same tokens, NOT_FOUND otherwise.
+ */
+static int compare_splitting(const char* file_name) {
+	SourceManager blocks, bytes;
+	long line = 0;
+	int more, result = FOUND;
+
+	if (!open_input_source(&blocks, file_name)) {
+		return NOT_FOUND;
+	}
+	if (!open_input_source(&bytes, file_name)) {
+		close_source_manager(&blocks);
+		return NOT_FOUND;
+	}
+	bytes.split_blocks = NOT_FOUND;
+
+	do {
+		line++;
+		more = next_source_line(&blocks);
+		if (more != next_source_line(&bytes) || blocks.span_count != bytes.span_count ||
+			memcmp(blocks.spans, bytes.spans, blocks.span_count * sizeof(TokenSpan)) != 0) {
+			printf("%s%s: line %ld is split into other tokens byte by byte\n", file_name, INPUT_FILE_EXTENSION, line);
+			result = NOT_FOUND;
+			break;
+		}
+	} while (more);
+
+	close_source_manager(&blocks);
+	close_source_manager(&bytes);
+	return result;
+}
+
+/**
+ * check_splitting -
+ * Times the splitting of the files' lines into tokens 16 bytes at a time with SSE2 and byte by byte,
+ * and checks that both give the same tokens. Only next_source_line is timed, the files are mapped once.
+ *
+ * @param files The base names of the files.
+ * @param file_count The number of files.
+ * @param lines The number of lines of all the files.
+ * @param iterations How many times each file is split each way, the shortest time is kept.
+ * @return OK if both ways give the same tokens on every file, !OK otherwise.
+ */
+static int check_splitting(char** files, int file_count, long lines, long iterations) {
+	double seconds[SPLITTING_COUNT];
+	long total_bytes = 0, tokens = 0;
+	int i, way, failed = 0;
+	long iteration;
+
+	memset(seconds, 0, sizeof(seconds));
+	for (i = 0; i < file_count; i++) {
+		SourceManager source;
+
+		if (!compare_splitting(files[i])) {
+			failed++;
+		}
+		if (!open_input_source(&source, files[i])) {
+			return !OK;
+		}
+		total_bytes += source.length;
+		for (way = 0; way < SPLITTING_COUNT; way++) {
+			double best = -1, start;
+			source.split_blocks = way == 0 ? FOUND : NOT_FOUND;
+			for (iteration = 0; iteration < iterations; iteration++) {
+				source.position = 0;
+				tokens = 0;
+				start = now_seconds();
+				while (next_source_line(&source)) {
+					tokens += source.span_count;
+				}
+				start = now_seconds() - start;
+				if (best < 0 || start < best) {
+					best = start;
+				}
+			}
+			seconds[way] += best;
+		}
+		close_source_manager(&source);
+	}
+
+#if !defined(__SSE2__) || !defined(__GNUC__)
+	printf("This build has no SSE2, both ways split byte by byte\n");
+#endif
+	printf("%d files, %ld lines, %ld bytes, %ld iterations\n", file_count, lines, total_bytes, iterations);
+	printf("%-20s %10s %14s %14s %10s\n", "splitting", "seconds", "lines/sec", "MB/sec", "speedup");
+	for (way = 0; way < SPLITTING_COUNT; way++) {
+		printf("%-20s %10.4f %14.0f %14.1f %10.2f\n", splitting_names[way], seconds[way],
+			seconds[way] > 0 ? (double)lines / seconds[way] : 0.0,
+			seconds[way] > 0 ? (double)total_bytes / seconds[way] / 1e6 : 0.0,
+			seconds[way] > 0 ? seconds[SPLITTING_COUNT - 1] / seconds[way] : 0.0);
+	}
+	if (failed > 0) {
+		printf("%d files are split into other tokens byte by byte\n", failed);
+		return !OK;
+	}
+	return OK;
+}
+
+/**
+ * make_path -
+ * Joins a directory, a name and an extension into the path of a file.
+ *
+ * @param directory The directory, NULL for none.
+ * @param name The name of the file.
+ * @param extension The extension, "" for none.
+ * @return A new string that must be freed, or NULL if memory allocation fails.
+ */
+static char* make_path(const char* directory, const char* name, const char* extension) {
+	char* path = (char*)malloc((directory != NULL ? strlen(directory) + 1 : 0) + strlen(name) + strlen(extension) + 1);
+
+	if (path != NULL) {
+		sprintf(path, "%s%s%s%s", directory != NULL ? directory : "", directory != NULL ? "/" : "", name, extension);
+	}
+	return path;
+}
+
+/**
+ * copy_input -
+ * Copies the .as file of an input file into a directory.
+ *
+ * @param file_name The base name of the input file, without its extension.
+ * @param directory The directory to copy it to.
+ * @return FOUND if the file was copied, NOT_FOUND otherwise.
+ */
+static int copy_input(const char* file_name, const char* directory) {
+	SourceManager source;
+	char* copy_path = make_path(directory, base_name(file_name), INPUT_FILE_EXTENSION);
+	FILE* copy;
+	int result = NOT_FOUND;
+
+	if (copy_path == NULL || !open_input_source(&source, file_name)) {
+		free(copy_path);
+		return NOT_FOUND;
+	}
+	copy = fopen(copy_path, "wb");
+	if (copy != NULL) {
+		result = (long)fwrite(source.data, 1, (size_t)source.length, copy) == source.length ? FOUND : NOT_FOUND;
+		if (fclose(copy) != 0) {
+			result = NOT_FOUND;
+		}
+	}
+	close_source_manager(&source);
+	free(copy_path);
+	return result;
+}
+
+/**
+ * prepare_path_directory -
+ * Makes the directory a path writes its files to, with a copy of every input file.
+ *
+ * @param work_directory The directory of the paths' directories.
+ * @param path The path.
+ * @param files The base names of the input files.
+ * @param file_count The number of files.
+ * @return The path of the directory, a new string that must be freed, or NULL if it couldn't be made.
+ */
+static char* prepare_path_directory(const char* work_directory, const DifferentialPath* path, char** files, int file_count) {
+	char* directory = make_path(work_directory, path->name, "");
+	int i;
+
+	if (directory == NULL) {
+		return NULL;
+	}
+	/* The directories may be there from an earlier run*/
+	mkdir(work_directory, 0777);
+	mkdir(directory, 0777);
+	for (i = 0; i < file_count; i++) {
+		if (!copy_input(files[i], directory)) {
+			fprintf(stderr, "Failed to copy %s%s to %s\n", files[i], INPUT_FILE_EXTENSION, directory);
+			free(directory);
+			return NULL;
+		}
+	}
+	return directory;
+}
+
+/**
+ * remove_outputs -
+ * Removes the files a path wrote, so a file it doesn't write again isn't compared.
+ *
+ * @param directory The directory of the path.
+ * @param files The base names of the input files.
+ * @param file_count The number of files.
+ */
+static void remove_outputs(const char* directory, char** files, int file_count) {
+	char* output_path;
+	int i, extension;
+
+	for (i = 0; i < file_count; i++) {
+		for (extension = 0; extension < OUTPUT_EXTENSION_COUNT; extension++) {
+			output_path = make_path(directory, base_name(files[i]), output_extensions[extension]);
+			if (output_path != NULL) {
+				remove(output_path);
+				free(output_path);
+			}
+		}
+	}
+	output_path = make_path(directory, ERRORS_FILE_NAME, "");
+	if (output_path != NULL) {
+		remove(output_path);
+		free(output_path);
+	}
+}
+
+/**
+ * run_assembler -
+ * Runs the assembler program once on the copies of all the files in a directory,
+ * with the options of a path. Its errors are written to the directory's errors file.
+ *
+ * @param assembler The path of the assembler program.
+ * @param path The path.
+ * @param directory The directory of the path.
+ * @param files The base names of the input files.
+ * @param file_count The number of files.
+ * @return The status system gives, -1 if memory allocation failed.
+ */
+static int run_assembler(const char* assembler, const DifferentialPath* path, const char* directory, char** files, int file_count) {
+	size_t size = strlen(assembler) + strlen(path->options) + strlen(directory) + strlen(ERRORS_FILE_NAME) + 32;
+	size_t used;
+	char* command;
+	int i, status;
+
+	for (i = 0; i < file_count; i++) {
+		size += strlen(directory) + strlen(base_name(files[i])) + 4;
+	}
+	command = (char*)malloc(size);
+	if (command == NULL) {
+		return -1;
+	}
+
+	/* The file names are quoted, the options are not: "-j 4" is two arguments*/
+	used = sprintf(command, "'%s' %s", assembler, path->options);
+	for (i = 0; i < file_count; i++) {
+		used += sprintf(command + used, " '%s/%s'", directory, base_name(files[i]));
+	}
+	sprintf(command + used, " > /dev/null 2> '%s/%s'", directory, ERRORS_FILE_NAME);
+	status = system(command);
+	free(command);
+	return status;
+}
+
+/**
+ * write_library_files -
+ * Assembles a file with assemble_source and writes its .ob, .ext and .ent files with the assembler's writers.
+ *
+ * @param file_name The path of the file, without its extension.
+ * @param errors_file The file the errors are written to.
+ */
+static void write_library_files(char* file_name, FILE* errors_file) {
+	SourceManager source;
+	Assembly assembly;
+	AssemblerManager words;
+	SymbolsManager references;
+
+	if (!open_input_source(&source, file_name)) {
+		return;
+	}
+	assemble_source(source.data, source.length, &assembly);
+	close_source_manager(&source);
+
+	if (!assembly.has_errors) {
+		/* printObjToFile and printReferenceSymbolsToFile read only these fields of the managers*/
+		memset(&words, 0, sizeof(words));
+		words.allocator = &assembly.scan_allocator;
+		words.IC = assembly.code_count;
+		words.DC = assembly.data_count;
+		words.actionItems = (Item*)assembly.code;
+		words.actionItemCount = assembly.code_count;
+		words.dataItems = (Item*)assembly.data;
+		words.dataItemCount = assembly.data_count;
+		memset(&references, 0, sizeof(references));
+		references.allocator = &assembly.scan_allocator;
+		references.ref_symbols = (ReferenceSymbol*)assembly.references;
+		references.ref_used = assembly.reference_count;
+
+		set_error_log(&assembly.errors);
+		printObjToFile(file_name, &words);
+		printReferenceSymbolsToFile(file_name, &references);
+		set_error_log(NULL);
+	}
+	print_error_log(&assembly.errors, errors_file);
+	release_assembly(&assembly);
+}
+
+/**
+ * write_path_files -
+ * Assembles a file in this process the way a path does, and writes its files the way the assembler does:
+ * the .am file once the macros are expanded, then the .ob, .ext and .ent files if there are no errors.
+ *
+ * @param path The path.
+ * @param file_name The path of the file, without its extension.
+ * @param registers The registers' names.
+ * @param registers_2 The indirect registers' names.
+ * @param errors_file The file the errors are written to.
+ */
+static void write_path_files(const DifferentialPath* path, char* file_name, Registers* registers, Registers_2* registers_2, FILE* errors_file) {
+	FileManager fileManager;
+	MacroManager macroManager;
+	AssemblerManager* assemblerManager;
+	SymbolsManager* symbolsManager;
+	Arena arena;
+	Arena scan_arena;
+	Allocator allocator;
+	Allocator scan_allocator;
+	ErrorLog errors;
+	int expanded;
+
+	if (path->kind == LibraryPath) {
+		write_library_files(file_name, errors_file);
+		return;
+	}
+
+	init_arena(&arena);
+	init_arena(&scan_arena);
+	init_allocator(&allocator, path->allocator, &arena);
+	init_allocator(&scan_allocator, path->allocator, &scan_arena);
+	init_error_log(&errors);
+	set_error_log(&errors);
+
+	initialize_file_manager(&fileManager, &allocator);
+	init_macro_manager(&macroManager, &allocator);
+	assemblerManager = createAssemblerManager(&scan_allocator);
+	symbolsManager = createSymbolsManager(&scan_allocator);
+	if (assemblerManager != NULL && symbolsManager != NULL) {
+		if (path->kind == PipelinePath) {
+			expanded = run_first_pass(&fileManager, &macroManager, file_name, assemblerManager, symbolsManager, registers, registers_2, NULL);
+		}
+		else {
+			expanded = input_process(&fileManager, &macroManager, file_name);
+			if (expanded) {
+				first_scan(&macroManager, &fileManager, assemblerManager, symbolsManager, registers, registers_2);
+			}
+		}
+		if (expanded && printPostMacroToFile(file_name, &fileManager, PostMacroTable)) {
+			updateLocationDataSymbols(symbolsManager, assemblerManager);
+			updateDataItemsLocation(assemblerManager);
+			second_scan(assemblerManager, symbolsManager);
+			if (assemblerManager->has_assembler_errors == NOT_FOUND && symbolsManager->has_symbols_errors == NOT_FOUND) {
+				printObjToFile(file_name, assemblerManager);
+				printReferenceSymbolsToFile(file_name, symbolsManager);
+			}
+		}
+	}
+
+	set_error_log(NULL);
+	print_error_log(&errors, errors_file);
+	release_allocator(&scan_allocator);
+	release_allocator(&allocator);
+}
+
+/**
+ * run_path -
+ * Assembles all the files the way a path does, writing their files to the path's directory.
+ *
+ * @param assembler The path of the assembler program.
+ * @param path The path.
+ * @param directory The directory of the path, it holds copies of the input files.
+ * @param files The base names of the input files.
+ * @param file_count The number of files.
+ * @param registers The registers' names.
+ * @param registers_2 The indirect registers' names.
+ * @return The status of the assembler program for an AssemblerPath, 0 for the others, -1 if the path couldn't run.
+ */
+static int run_path(const char* assembler, const DifferentialPath* path, const char* directory, char** files, int file_count,
+	Registers* registers, Registers_2* registers_2) {
+	char* errors_path;
+	char* file_name;
+	FILE* errors_file;
+	int i;
+
+	if (path->kind == AssemblerPath) {
+		return run_assembler(assembler, path, directory, files, file_count);
+	}
+
+	errors_path = make_path(directory, ERRORS_FILE_NAME, "");
+	errors_file = errors_path != NULL ? fopen(errors_path, "w") : NULL;
+	free(errors_path);
+	if (errors_file == NULL) {
+		return -1;
+	}
+	for (i = 0; i < file_count; i++) {
+		file_name = make_path(directory, base_name(files[i]), "");
+		if (file_name != NULL) {
+			write_path_files(path, file_name, registers, registers_2, errors_file);
+			free(file_name);
+		}
+	}
+	fclose(errors_file);
+	return 0;
+}
+
+/**
+ * print_line_at -
+ * Prints the line of a text that holds a position.
+ *
+ * @param label What the text is.
+ * @param text The text.
+ * @param length The number of characters in the text.
+ * @param position The position in the text.
+ */
+static void print_line_at(const char* label, const char* text, long length, long position) {
+	long start = position, end = position;
+
+	if (text == NULL || position >= length) {
+		printf("    %-20s (no more lines)\n", label);
+		return;
+	}
+	while (start > 0 && text[start - 1] != '\n') {
+		start--;
+	}
+	while (end < length && text[end] != '\n') {
+		end++;
+	}
+	printf("    %-20s %.*s\n", label, (int)(end - start), text + start);
+}
+
+/**
+ * compare_texts -
+ * Compares a text with the one it must match byte for byte, and prints the first line that differs.
+ *
+ * @param label What the texts are, the name of their file.
+ * @param name Who wrote the text.
+ * @param text The text.
+ * @param length The number of characters in the text.
+ * @param expected_name Who wrote the text it must match.
+ * @param expected The text it must match.
+ * @param expected_length The number of characters in expected.
+ * @return FOUND if both have the same bytes, NOT_FOUND otherwise.
+ */
+static int compare_texts(const char* label, const char* name, const char* text, long length,
+	const char* expected_name, const char* expected, long expected_length) {
+	long position = 0, line = 1;
+
+	while (position < length && position < expected_length && text[position] == expected[position]) {
+		if (text[position] == '\n') {
+			line++;
+		}
+		position++;
+	}
+	if (position < length || position < expected_length) {
+		printf("%s: %s differs from %s at line %ld\n", label, name, expected_name, line);
+		print_line_at(expected_name, expected, expected_length, position);
+		print_line_at(name, text, length, position);
+		return NOT_FOUND;
+	}
+	return FOUND;
+}
+
+/**
+ * compare_files -
+ * Compares a file with the one it must match byte for byte, and prints the first line that differs.
+ * A line of the .ob file is an address and its word, so that line gives the first word that differs.
+ *
+ * @param name Who wrote the file.
+ * @param file_path The path of the file.
+ * @param expected_name Who wrote the file it must match.
+ * @param expected_path The path of the file it must match.
+ * @return FOUND if both are missing or have the same bytes, NOT_FOUND otherwise.
+ */
+static int compare_files(const char* name, const char* file_path, const char* expected_name, const char* expected_path) {
+	SourceManager file, expected;
+	int has_file = open_source_manager(&file, file_path);
+	int has_expected = open_source_manager(&expected, expected_path);
+	int result = FOUND;
+
+	if (has_file != has_expected) {
+		printf("%s: %s %s it and %s %s\n", base_name(file_path), name, has_file ? "writes" : "doesn't write",
+			expected_name, has_expected ? "does" : "doesn't");
+		result = NOT_FOUND;
+	}
+	else if (has_file) {
+		result = compare_texts(base_name(file_path), name, file.data, file.length, expected_name, expected.data, expected.length);
+	}
+	if (has_file) {
+		close_source_manager(&file);
+	}
+	if (has_expected) {
+		close_source_manager(&expected);
+	}
+	return result;
+}
+
+/**
+ * append_error_messages -
+ * Appends the messages of a file of errors to a text. Where an error was found in the assembler's
+ * source ("Error in function ... at line ... in file ...: ") is left out: it changes whenever the
+ * source does, the messages and their order are what the golden errors hold the paths to.
+ *
+ * @param file_path The path of the file of errors.
+ * @param text The text to append to, it grows as needed. May point to NULL.
+ * @param length The number of characters in the text, updated.
+ * @return FOUND if the file was appended or is missing, NOT_FOUND if memory allocation failed.
+ */
+static int append_error_messages(const char* file_path, char** text, long* length) {
+	SourceManager errors;
+	const char* line;
+	const char* end;
+	const char* location;
+	char* new_text;
+	long position = 0, line_length;
+
+	if (!open_source_manager(&errors, file_path)) {
+		return FOUND;
+	}
+	new_text = (char*)realloc(*text, (size_t)(*length + errors.length + 1));
+	if (new_text == NULL) {
+		close_source_manager(&errors);
+		return NOT_FOUND;
+	}
+	*text = new_text;
+
+	while (position < errors.length) {
+		line = errors.data + position;
+		end = (const char*)memchr(line, '\n', (size_t)(errors.length - position));
+		line_length = end != NULL ? (long)(end - line) + 1 : errors.length - position;
+		position += line_length;
+
+		if (line_length > (long)strlen(ERROR_LOCATION_START) && strncmp(line, ERROR_LOCATION_START, strlen(ERROR_LOCATION_START)) == 0) {
+			/* The message follows the first ": " after the file name*/
+			for (location = line; location + 1 < line + line_length; location++) {
+				if (strncmp(location, ERROR_LOCATION_FILE, strlen(ERROR_LOCATION_FILE)) == 0) {
+					break;
+				}
+			}
+			for (; location + 1 < line + line_length; location++) {
+				if (location[0] == ':' && location[1] == ' ') {
+					line_length -= (long)(location + 2 - line);
+					line = location + 2;
+					break;
+				}
+			}
+		}
+		memcpy(*text + *length, line, (size_t)line_length);
+		*length += line_length;
+	}
+	close_source_manager(&errors);
+	return FOUND;
+}
+
+/**
+ * compare_path_files -
+ * Compares the files a path wrote for an input file with the reference's and with the checked-in ones.
+ *
+ * @param path The index of the path in differential_paths.
+ * @param directories The directories of the paths.
+ * @param file_name The base name of the input file.
+ * @param golden FOUND if the files of the input file are checked in next to it.
+ * @return The number of files that differ.
+ */
+static int compare_path_files(int path, char** directories, const char* file_name, int golden) {
+	const DifferentialPath* reference = &differential_paths[0];
+	char* file_path;
+	char* expected_path;
+	int extension, differences = 0;
+
+	for (extension = 0; extension < OUTPUT_EXTENSION_COUNT; extension++) {
+		if ((differential_paths[path].writes & output_writers[extension]) == 0) {
+			continue;
+		}
+		file_path = make_path(directories[path], base_name(file_name), output_extensions[extension]);
+		if (file_path == NULL) {
+			return differences + 1;
+		}
+		if (path > 0 && (reference->writes & output_writers[extension]) != 0) {
+			expected_path = make_path(directories[0], base_name(file_name), output_extensions[extension]);
+			if (expected_path == NULL || !compare_files(differential_paths[path].name, file_path, reference->name, expected_path)) {
+				differences++;
+			}
+			free(expected_path);
+		}
+		if (golden) {
+			expected_path = make_path(NULL, file_name, output_extensions[extension]);
+			if (expected_path == NULL || !compare_files(differential_paths[path].name, file_path, "checked-in", expected_path)) {
+				differences++;
+			}
+			free(expected_path);
+		}
+		free(file_path);
+	}
+	return differences;
+}
+
+/**
+ * check_paths -
+ * Assembles all the files with every path, each path writing to its own directory, then checks byte for byte
+ * that each path wrote the files and the errors the reference wrote, and that the files of the inputs whose
+ * outputs are checked in match them. When every input has checked-in outputs, the messages of each path's
+ * errors must also be the checked-in ones, in the order of the files (see append_error_messages).
+ * Prints the time of each path and how it compares with the reference's.
+ *
+ * @param files The base names of the files.
+ * @param goldens FOUND for each file whose outputs are checked in next to it.
+ * @param file_count The number of files.
+ * @param lines The number of lines of all the files.
+ * @param iterations How many times each path assembles the files, the shortest time is kept.
+ * @param work_directory The directory of the paths' directories.
+ * @param assembler The path of the assembler program.
+ * @param registers The registers' names.
+ * @param registers_2 The indirect registers' names.
+ * @return OK if every path wrote the reference's files and errors and the checked-in files, !OK otherwise.
+ */
+static int check_paths(char** files, const int* goldens, int file_count, long lines, long iterations, const char* work_directory,
+	const char* assembler, Registers* registers, Registers_2* registers_2) {
+	double seconds[DIFFERENTIAL_PATH_COUNT];
+	int differences[DIFFERENTIAL_PATH_COUNT];
+	int statuses[DIFFERENTIAL_PATH_COUNT];
+	char* directories[DIFFERENTIAL_PATH_COUNT];
+	char* errors_path;
+	char* reference_errors_path;
+	char* golden_errors = NULL;
+	char* errors = NULL;
+	long golden_errors_length = 0, errors_length;
+	int i, j, path, checked_in, failed = 0;
+	long iteration;
+
+	/* Every path writes to a directory named after it, so the inputs' base names must differ*/
+	for (i = 0; i < file_count; i++) {
+		for (j = 0; j < i; j++) {
+			if (strcmp(base_name(files[i]), base_name(files[j])) == 0) {
+				fprintf(stderr, "--differential needs input files with different names, %s and %s\n", files[j], files[i]);
+				return !OK;
+			}
+		}
+	}
+
+	memset(differences, 0, sizeof(differences));
+	for (path = 0; path < DIFFERENTIAL_PATH_COUNT; path++) {
+		directories[path] = prepare_path_directory(work_directory, &differential_paths[path], files, file_count);
+		if (directories[path] == NULL) {
+			while (--path >= 0) {
+				free(directories[path]);
+			}
+			return !OK;
+		}
+	}
+
+	for (path = 0; path < DIFFERENTIAL_PATH_COUNT; path++) {
+		double best = -1;
+		for (iteration = 0; iteration < iterations; iteration++) {
+			double start;
+			remove_outputs(directories[path], files, file_count);
+			start = now_seconds();
+			statuses[path] = run_path(assembler, &differential_paths[path], directories[path], files, file_count, registers, registers_2);
+			start = now_seconds() - start;
+			if (best < 0 || start < best) {
+				best = start;
+			}
+		}
+		seconds[path] = best;
+	}
+
+	/* The errors don't say which file they are of, so they are held to the golden errors only when every file has them*/
+	for (i = 0, checked_in = 0; i < file_count; i++) {
+		checked_in += goldens[i] ? 1 : 0;
+	}
+	for (i = 0; i < file_count && checked_in == file_count; i++) {
+		errors_path = make_path(NULL, files[i], GOLDEN_ERRORS_EXTENSION);
+		if (errors_path == NULL || !append_error_messages(errors_path, &golden_errors, &golden_errors_length)) {
+			fprintf(stderr, "Failed to read the golden errors of %s\n", files[i]);
+			failed++;
+		}
+		free(errors_path);
+	}
+
+	/* The files of the last iteration are compared*/
+	for (path = 0; path < DIFFERENTIAL_PATH_COUNT; path++) {
+		if (statuses[path] != statuses[0]) {
+			printf("%s exited with status %d and %s with %d\n", differential_paths[path].name, statuses[path],
+				differential_paths[0].name, statuses[0]);
+			differences[path]++;
+		}
+		for (i = 0; i < file_count; i++) {
+			differences[path] += compare_path_files(path, directories, files[i], goldens[i]);
+		}
+		if (path > 0 && (differential_paths[path].writes & PATH_WRITES_ERRORS) != 0) {
+			errors_path = make_path(directories[path], ERRORS_FILE_NAME, "");
+			reference_errors_path = make_path(directories[0], ERRORS_FILE_NAME, "");
+			if (errors_path == NULL || reference_errors_path == NULL ||
+				!compare_files(differential_paths[path].name, errors_path, differential_paths[0].name, reference_errors_path)) {
+				differences[path]++;
+			}
+			free(errors_path);
+			free(reference_errors_path);
+		}
+		if (checked_in == file_count && (differential_paths[path].writes & PATH_WRITES_ERRORS) != 0) {
+			errors_length = 0;
+			errors_path = make_path(directories[path], ERRORS_FILE_NAME, "");
+			if (errors_path == NULL || !append_error_messages(errors_path, &errors, &errors_length) ||
+				!compare_texts(ERRORS_FILE_NAME, differential_paths[path].name, errors, errors_length,
+					"checked-in", golden_errors, golden_errors_length)) {
+				differences[path]++;
+			}
+			free(errors_path);
+		}
+		failed += differences[path];
+	}
+	free(golden_errors);
+	free(errors);
+	printf("%d files, %ld lines, %ld iterations, compared with %s and the checked-in files of %d%s, written to %s\n",
+		file_count, lines, iterations, differential_paths[0].name, checked_in,
+		checked_in == file_count ? " and their errors" : "", work_directory);
+	printf("%-20s %10s %14s %10s %12s\n", "path", "seconds", "lines/sec", "speedup", "differences");
+	for (path = 0; path < DIFFERENTIAL_PATH_COUNT; path++) {
+		printf("%-20s %10.4f %14.0f %10.2f %12d\n", differential_paths[path].name, seconds[path],
+			seconds[path] > 0 ? (double)lines / seconds[path] : 0.0,
+			seconds[path] > 0 ? seconds[0] / seconds[path] : 0.0, differences[path]);
+		free(directories[path]);
+	}
+	if (failed > 0) {
+		printf("%d files differ from the reference or the checked-in files\n", failed);
+		return !OK;
+	}
+	return OK;
+}
+
+/**
+ * bench_phases -
+ * Assembles every file --iterations times and prints the time, the throughput in source lines,
+ * the allocations and the growth of the peak resident set size of each phase.
+ *
+ * @param files The base names of the files.
+ * @param file_count The number of files.
+ * @param lines The number of lines of all the files.
+ * @param iterations How many times each file is assembled.
+ * @param format How the .am files are written.
+ * @param kind Where the memory of the files is taken from.
+ * @param registers The registers' names.
+ * @param registers_2 The indirect registers' names.
+ * @return OK.
+ */
+static int bench_phases(char** files, int file_count, long lines, long iterations, PostMacroFormat format, AllocatorKind kind,
+	Registers* registers, Registers_2* registers_2) {
+	PhaseStats stats[PHASE_COUNT];
+	double total_seconds = 0;
+	unsigned long total_allocations = 0;
+	long total_rss_growth = 0, iteration;
+	int i, phase, failed = 0;
+
+	memset(stats, 0, sizeof(stats));
+	for (iteration = 0; iteration < iterations; iteration++) {
+		for (i = 0; i < file_count; i++) {
+			if (!bench_file(files[i], format, kind, registers, registers_2, stats)) {
+				failed++;
+			}
+		}
+	}
+
+	printf("%d files, %ld lines, %ld iterations, %s allocator\n", file_count, lines, iterations, allocator_name(kind));
+	printf("%-14s %10s %14s %14s %16s %14s\n", "phase", "seconds", "lines/sec", "allocations", "RSS growth (KB)", "peak RSS (KB)");
+	for (phase = 0; phase < PHASE_COUNT; phase++) {
+		printf("%-14s %10.4f %14.0f %14lu %16ld %14s\n", phase_names[phase], stats[phase].seconds,
+			stats[phase].seconds > 0 ? (double)lines * iterations / stats[phase].seconds : 0.0,
+			stats[phase].allocations, stats[phase].rss_growth, "");
+		total_seconds += stats[phase].seconds;
+		total_allocations += stats[phase].allocations;
+		total_rss_growth += stats[phase].rss_growth;
+	}
+	printf("%-14s %10.4f %14.0f %14lu %16ld %14ld\n", "total", total_seconds,
+		total_seconds > 0 ? (double)lines * iterations / total_seconds : 0.0, total_allocations, total_rss_growth, peak_rss());
+	if (failed > 0) {
+		printf("%d assemblies had errors, their later phases were not timed\n", failed);
+	}
+	return OK;
+}
+
+/*
+Benchmarks the phases of the assembler on input files.
+Every file is assembled --iterations times, then the time, the throughput in source lines,
+the allocations and the growth of the peak resident set size of each phase are printed, and the
+peak of the whole run on the total line.
+With --differential, the files are assembled by each path of differential_paths into its own directory
+under --work-dir, the assembler program given by --assembler runs the paths that use it, and the run
+fails when a path writes other .am, .ob, .ext or .ent files or errors than the first one, or when the
+files of an input given as --golden=FILE differ from the ones checked in next to it; when every input
+is given that way, the messages of the errors must also be the ones in their .errors files (see check_paths).
+With --scaling, the files are pairs of a small and a large file and the run fails when a large
+file takes more than --bound times what its size explains (see check_scaling).
+With --formatting, no files are read: every word is formatted as a line of the .ob file, the way
+printObjToFile does and the way it did before (see check_formatting).
+With --encoding, no files are read: the instruction encoders encode every word they can make,
+and the run fails if they allocate (see check_encoding).
+With --splitting, the lines of the files are split into tokens with SSE2 and byte by byte, and the
+run fails if the tokens differ (see check_splitting).
+@param int argc
+@param char** argv [--iterations=N] [--am=table|plain|none] [--allocator=system|bump|counting]
+                   [--scaling [--bound=X] | --differential [--work-dir=DIR] [--assembler=PATH] | --splitting]
+                   [--golden=]file... (with or without .as) | --formatting | --encoding
+@return int 0 if OK 1 otherwise
+*/
+int main(int argc, char** argv) {
+	Registers registers[NUM_OF_REGISTERS];
+	Registers_2 registers_2[NUM_OF_REGISTERS];
+	PostMacroFormat format = PostMacroTable;
+	AllocatorKind kind = DEFAULT_ALLOCATOR;
+	long iterations = 10, lines = 0, file_lines;
+	double bound = SCALING_BOUND;
+	int i, result, file_count = 0, scaling = NOT_FOUND, differential = NOT_FOUND, formatting = NOT_FOUND, encoding = NOT_FOUND, splitting = NOT_FOUND;
+	char** files = argv + 1;
+	const char* work_directory = DIFFERENTIAL_DIRECTORY;
+	const char* assembler = ASSEMBLER_PROGRAM;
+	int* goldens = (int*)calloc(argc, sizeof(int));
+
+	if (goldens == NULL) {
+		fprintf(stderr, "Failed to allocate memory\n");
+		return !OK;
+	}
+	initialize_operands(registers, registers_2);
+
+	for (i = 1; i < argc; i++) {
+		if (strncmp(argv[i], "--iterations=", 13) == 0) {
+			iterations = atol(argv[i] + 13);
+			if (iterations <= 0) {
+				fprintf(stderr, "--iterations needs a positive number\n");
+				free(goldens);
+				return !OK;
+			}
+		}
+		else if (strcmp(argv[i], "--am=table") == 0) format = PostMacroTable;
+		else if (strcmp(argv[i], "--am=plain") == 0) format = PostMacroPlain;
+		else if (strcmp(argv[i], "--am=none") == 0) format = PostMacroNone;
+		else if (strncmp(argv[i], "--allocator=", 12) == 0) {
+			if (!find_allocator_kind(argv[i] + 12, &kind)) {
+				fprintf(stderr, "--allocator must be system, bump or counting\n");
+				free(goldens);
+				return !OK;
+			}
+		}
+		else if (strcmp(argv[i], "--scaling") == 0) scaling = FOUND;
+		else if (strcmp(argv[i], "--differential") == 0) differential = FOUND;
+		else if (strcmp(argv[i], "--formatting") == 0) formatting = FOUND;
+		else if (strcmp(argv[i], "--encoding") == 0) encoding = FOUND;
+		else if (strcmp(argv[i], "--splitting") == 0) splitting = FOUND;
+		else if (strncmp(argv[i], "--bound=", 8) == 0) {
+			bound = atof(argv[i] + 8);
+			if (bound <= 0) {
+				fprintf(stderr, "--bound needs a positive number\n");
+				free(goldens);
+				return !OK;
+			}
+		}
+		else if (strncmp(argv[i], "--work-dir=", 11) == 0 && argv[i][11] != '\0') work_directory = argv[i] + 11;
+		else if (strncmp(argv[i], "--assembler=", 12) == 0 && argv[i][12] != '\0') assembler = argv[i] + 12;
+		else {
+			char* file_name = argv[i];
+			size_t length, extension_length = strlen(INPUT_FILE_EXTENSION);
+			/* --golden=FILE is an input file whose .am, .ob, .ext, .ent and .errors files are checked in next to it*/
+			if (strncmp(file_name, "--golden=", 9) == 0) {
+				file_name += 9;
+				goldens[file_count] = FOUND;
+			}
+			/* The files may be given with their extension*/
+			length = strlen(file_name);
+			if (length > extension_length && strcmp(file_name + length - extension_length, INPUT_FILE_EXTENSION) == 0) {
+				file_name[length - extension_length] = '\0';
+			}
+			file_lines = count_source_lines(file_name, NULL);
+			if (file_lines < 0) {
+				fprintf(stderr, "Failed to read %s%s\n", file_name, INPUT_FILE_EXTENSION);
+				free(goldens);
+				return !OK;
+			}
+			lines += file_lines;
+			/* The files are gathered at the start of argv, in their order*/
+			files[file_count++] = file_name;
+		}
+	}
+	if (formatting) {
+		result = check_formatting(iterations);
+	}
+	else if (encoding) {
+		result = check_encoding(iterations);
+	}
+	else if (file_count == 0) {
+		fprintf(stderr, "usage: %s [--iterations=N] [--am=table|plain|none] [--allocator=system|bump|counting]"
+			" [--scaling [--bound=X] | --differential [--work-dir=DIR] [--assembler=PATH] | --splitting] [--golden=]file..."
+			" | --formatting | --encoding\n", argv[0]);
+		result = !OK;
+	}
+	else if (scaling) {
+		result = check_scaling(files, file_count, bound, format, kind, iterations, registers, registers_2);
+	}
+	else if (differential) {
+		result = check_paths(files, goldens, file_count, lines, iterations, work_directory, assembler, registers, registers_2);
+	}
+	else if (splitting) {
+		result = check_splitting(files, file_count, lines, iterations);
+	}
+	else {
+		result = bench_phases(files, file_count, lines, iterations, format, kind, registers, registers_2);
+	}
+	free(goldens);
+	return result;
+}
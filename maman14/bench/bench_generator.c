@@ -0,0 +1,303 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "actions.h"
+#include "constants.h"
+
+#define IMMEDIATE_LIMIT 2048   /* Immediate operands fit 12 bits, two's complement*/
+#define DATA_LIMIT 16384       /* Data numbers fit 15 bits, two's complement*/
+#define MEMORY_SIZE 4096       /* Direct operands fit 12 bits*/
+#define MACRO_PERCENT 5        /* Percent of the lines that invoke a macro, when there are macros*/
+#define MAX_DATA_NUMBERS 6     /* Most numbers in a .data line, unless --data-size is given*/
+#define MAX_STRING_LENGTH 12   /* Longest .string, unless --string-size is given*/
+
+/* What the generated program is made of*/
+typedef struct {
+	long lines;       /* Lines of the program, without the declarations and macro definitions*/
+	long labels;      /* Labels defined in the program*/
+	long macros;      /* Macros defined at the start*/
+	long macro_size;  /* Lines in each macro*/
+	long externs;     /* .extern names, percent of the labels, over 100 for more names than labels*/
+	long entries;     /* .entry labels, percent of the labels*/
+	long data;        /* Percent of the lines that are .data*/
+	long strings;     /* Percent of the lines that are .string*/
+	long data_size;   /* Most numbers in a .data line*/
+	long string_size; /* Longest .string*/
+	long seed;
+} GeneratorOptions;
+
+/* The generator's own random numbers, so a seed gives the same program everywhere*/
+static unsigned long random_state;
+
+static const char* action_names[NUM_OF_ACTIONS] = {
+	"mov", "cmp", "add", "sub", "lea", "clr", "not", "inc",
+	"dec", "jmp", "bne", "red", "prn", "jsr", "rts", "stop"
+};
+
+/**
+ * next_random -
+ * Gives the next random number of the generator.
+ *
+ * @param limit The number of possible values.
+ * @return A number from 0 to limit - 1.
+ */
+static long next_random(long limit) {
+	random_state = (random_state * 1103515245UL + 12345UL) & 0xFFFFFFFFUL;
+	return limit > 0 ? (long)((random_state >> 8) % (unsigned long)limit) : 0;
+}
+
+/**
+ * print_label_name -
+ * Prints the name of a label operand: a label of the program or an .extern name.
+ *
+ * @param options The options of the program.
+ * @param extern_count The number of .extern names.
+ */
+static void print_label_name(const GeneratorOptions* options, long extern_count) {
+	long index = next_random(options->labels + extern_count);
+	if (index < options->labels) {
+		printf("L%ld", index);
+	}
+	else {
+		printf("X%ld", index - options->labels);
+	}
+}
+
+/**
+ * print_operand -
+ * Prints an operand in one of the addressing modes an action allows.
+ *
+ * @param options The options of the program.
+ * @param extern_count The number of .extern names.
+ * @param modes The ADDRESSING_* bits the operand may use.
+ * @return The mode that was printed.
+ */
+static int print_operand(const GeneratorOptions* options, long extern_count, int modes) {
+	int mode;
+
+	/* Without labels no operand can be direct*/
+	if (options->labels + extern_count == 0 && modes != ADDRESSING_DIRECT) {
+		modes &= ~ADDRESSING_DIRECT;
+	}
+	do {
+		mode = 1 << next_random(4);
+	} while ((modes & mode) == 0);
+
+	switch (mode) {
+	case ADDRESSING_IMMEDIATE:
+		printf("#%ld", next_random(2 * IMMEDIATE_LIMIT) - IMMEDIATE_LIMIT);
+		break;
+	case ADDRESSING_DIRECT:
+		print_label_name(options, extern_count);
+		break;
+	case ADDRESSING_INDIRECT_REGISTER:
+		printf("*r%ld", next_random(NUM_OF_REGISTERS));
+		break;
+	default:
+		printf("r%ld", next_random(NUM_OF_REGISTERS));
+		break;
+	}
+	return mode;
+}
+
+/**
+ * print_action_line -
+ * Prints an action with operands it allows.
+ *
+ * @param options The options of the program.
+ * @param extern_count The number of .extern names.
+ * @return The number of words of the action.
+ */
+static long print_action_line(const GeneratorOptions* options, long extern_count) {
+	const Action* action;
+	int source_mode, target_mode;
+	long words = 1;
+
+	/* lea only takes a label, it can't be used without one*/
+	do {
+		action = find_action(action_names[next_random(NUM_OF_ACTIONS)]);
+	} while (action->source_modes == ADDRESSING_DIRECT && options->labels + extern_count == 0);
+
+	printf("%s", action->action_name);
+	if (action->operand_count == 2) {
+		printf(" ");
+		source_mode = print_operand(options, extern_count, action->source_modes);
+		printf(", ");
+		target_mode = print_operand(options, extern_count, action->destination_modes);
+		/* Two registers share one word*/
+		words += (source_mode & (ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER)) &&
+			(target_mode & (ADDRESSING_INDIRECT_REGISTER | ADDRESSING_DIRECT_REGISTER)) ? 1 : 2;
+	}
+	else if (action->operand_count == 1) {
+		printf(" ");
+		print_operand(options, extern_count, action->destination_modes);
+		words++;
+	}
+	printf("\n");
+	return words;
+}
+
+/**
+ * print_data_line -
+ * Prints a .data line of random numbers.
+ *
+ * @param options The options of the program.
+ * @return The number of words of the line.
+ */
+static long print_data_line(const GeneratorOptions* options) {
+	long i, count = 1 + next_random(options->data_size);
+	printf(".data ");
+	for (i = 0; i < count; i++) {
+		printf(i > 0 ? ", %ld" : "%ld", next_random(2 * DATA_LIMIT) - DATA_LIMIT);
+	}
+	printf("\n");
+	return count;
+}
+
+/**
+ * print_string_line -
+ * Prints a .string line of random letters.
+ *
+ * @param options The options of the program.
+ * @return The number of words of the line.
+ */
+static long print_string_line(const GeneratorOptions* options) {
+	long i, length = next_random(options->string_size + 1);
+	printf(".string \"");
+	for (i = 0; i < length; i++) {
+		putchar('a' + (int)next_random(26));
+	}
+	printf("\"\n");
+	return length + 1;
+}
+
+/**
+ * read_option -
+ * Reads a --name=value option.
+ *
+ * @param argument The command line argument.
+ * @param name The name of the option, with its dashes and equal sign.
+ * @param value Set to the value of the option.
+ * @return FOUND if the argument is this option with a number that is not negative, NOT_FOUND otherwise.
+ */
+static int read_option(const char* argument, const char* name, long* value) {
+	char* end;
+	size_t length = strlen(name);
+	if (strncmp(argument, name, length) != 0) {
+		return NOT_FOUND;
+	}
+	*value = strtol(argument + length, &end, 10);
+	if (*end != '\0' || end == argument + length || *value < 0) {
+		*value = -1;
+	}
+	return FOUND;
+}
+
+/*
+Writes a synthetic assembly program to the standard output, for benchmarking the assembler.
+The program is made of .extern declarations, macro definitions, then lines of actions, .data,
+.string and macro invocations with labels spread evenly among them, then .entry declarations.
+@param int argc
+@param char** argv --lines=N --labels=N --macros=N --macro-size=N --externs=PERCENT
+                   --entries=PERCENT --data=PERCENT --strings=PERCENT --data-size=N
+                   --string-size=N --seed=N
+@return int 0 if OK 1 otherwise
+*/
+int main(int argc, char** argv) {
+	GeneratorOptions options;
+	long extern_count, entry_count, next_label = 0, words = 0;
+	long i, j, kind;
+
+	options.lines = 1000;
+	options.labels = 100;
+	options.macros = 8;
+	options.macro_size = 4;
+	options.externs = 10;
+	options.entries = 10;
+	options.data = 10;
+	options.strings = 5;
+	options.data_size = MAX_DATA_NUMBERS;
+	options.string_size = MAX_STRING_LENGTH;
+	options.seed = 1;
+
+	for (i = 1; i < argc; i++) {
+		long* value = NULL;
+		long parsed;
+		if (read_option(argv[i], "--lines=", &parsed)) value = &options.lines;
+		else if (read_option(argv[i], "--labels=", &parsed)) value = &options.labels;
+		else if (read_option(argv[i], "--macros=", &parsed)) value = &options.macros;
+		else if (read_option(argv[i], "--macro-size=", &parsed)) value = &options.macro_size;
+		else if (read_option(argv[i], "--externs=", &parsed)) value = &options.externs;
+		else if (read_option(argv[i], "--entries=", &parsed)) value = &options.entries;
+		else if (read_option(argv[i], "--data=", &parsed)) value = &options.data;
+		else if (read_option(argv[i], "--strings=", &parsed)) value = &options.strings;
+		else if (read_option(argv[i], "--data-size=", &parsed)) value = &options.data_size;
+		else if (read_option(argv[i], "--string-size=", &parsed)) value = &options.string_size;
+		else if (read_option(argv[i], "--seed=", &parsed)) value = &options.seed;
+		if (value == NULL || parsed < 0) {
+			fprintf(stderr, "Unknown option or bad value: %s\n", argv[i]);
+			return !OK;
+		}
+		*value = parsed;
+	}
+	if (options.data + options.strings > 100 || options.entries > 100) {
+		fprintf(stderr, "The percents are more than 100\n");
+		return !OK;
+	}
+
+	random_state = (unsigned long)options.seed;
+	extern_count = options.labels * options.externs / 100;
+	entry_count = options.labels * options.entries / 100;
+
+	for (i = 0; i < extern_count; i++) {
+		printf(".extern X%ld\n", i);
+	}
+
+	/* The macros hold actions only, their labels would be defined again by every invocation*/
+	for (i = 0; i < options.macros; i++) {
+		printf("macr m%ld\n", i);
+		for (j = 0; j < options.macro_size; j++) {
+			printf(" ");
+			print_action_line(&options, extern_count);
+		}
+		printf("endmacr\n");
+	}
+
+	for (i = 0; i < options.lines; i++) {
+		int has_label = next_label < options.labels && next_label * options.lines <= i * options.labels;
+		if (has_label) {
+			printf("L%ld: ", next_label++);
+		}
+		kind = next_random(100);
+		if (kind < options.data) {
+			words += print_data_line(&options);
+		}
+		else if (kind < options.data + options.strings) {
+			words += print_string_line(&options);
+		}
+		else if (!has_label && options.macros > 0 && kind < options.data + options.strings + MACRO_PERCENT) {
+			/* The words of the macro are not counted, the estimate below is only a warning*/
+			printf("m%ld\n", next_random(options.macros));
+		}
+		else {
+			words += print_action_line(&options, extern_count);
+		}
+	}
+
+	/* The labels that did not fit the lines*/
+	for (; next_label < options.labels; next_label++) {
+		printf("L%ld: .data %ld\n", next_label, next_label);
+		words++;
+	}
+
+	for (i = 0; i < entry_count; i++) {
+		printf(".entry L%ld\n", i * options.labels / entry_count);
+	}
+
+	if (FIRST_MEMORY_PLACE + words > MEMORY_SIZE) {
+		fprintf(stderr, "Warning: the program takes more than %ld words, labels past address %d can't be encoded\n",
+			words, MEMORY_SIZE - 1);
+	}
+	return OK;
+}
@@ -0,0 +1,20 @@
+; labels, actions and data that the first scan rejects
+.extern W
+MAIN: mov r3, LENGTH
+LOOP: jmp L1
+foo r3
+prn #-5
+.data 1, x, 3
+mov: .data 4
+r1: .data 2
+macr m_add
+ add r2, STR
+endmacr
+m_add
+.string "abc
+MAIN: stop
+L1: inc K
+STR: .string "abcd"
+LENGTH: .data 6, -9, 15
+K: .data 22
+END: stop
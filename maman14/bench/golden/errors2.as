@@ -0,0 +1,18 @@
+; symbols that only the second scan finds missing
+.entry LOOP
+.entry END
+.extern OUT
+MAIN: add r3, LIST
+LOOP: prn #48
+lea STR, r6
+inc r6
+mov *r6, OUT
+sub r1, r4
+cmp r3, #-6
+bne NOWHERE
+dec OUT
+jmp LOOP
+END: stop
+STR: .string "abcd"
+LIST: .data 6, -9
+.data -100
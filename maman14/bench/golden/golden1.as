@@ -0,0 +1,368 @@
+.extern X0
+.extern X1
+.extern X2
+.extern X3
+.extern X4
+.extern X5
+.extern X6
+.extern X7
+.extern X8
+.extern X9
+macr m0
+ rts
+ jmp r1
+ cmp #-12, L23
+ inc L30
+endmacr
+macr m1
+ stop
+ jsr r1
+ add #-1566, *r7
+ not L73
+endmacr
+macr m2
+ prn *r5
+ red *r7
+ stop
+ cmp r5, r1
+endmacr
+macr m3
+ clr r1
+ cmp *r6, #-1245
+ bne *r1
+ prn r3
+endmacr
+macr m4
+ dec r5
+ jmp *r7
+ sub r7, r2
+ stop
+endmacr
+macr m5
+ sub *r6, L8
+ clr *r5
+ stop
+ lea L70, *r5
+endmacr
+macr m6
+ rts
+ dec L2
+ rts
+ mov L98, L15
+endmacr
+macr m7
+ not L69
+ red *r6
+ add X0, r1
+ lea L15, L79
+endmacr
+L0: lea X4, L49
+.data 6971, 3664, 1597
+stop
+L1: .string "ltlld"
+prn *r6
+mov X7, X3
+L2: inc *r1
+red X2
+jsr #673
+L3: stop
+inc *r7
+dec L60
+L4: cmp #-1032, L68
+jmp L52
+mov L19, *r0
+L5: sub X3, L72
+m7
+bne L97
+L6: mov #921, L12
+red L42
+bne *r2
+L7: bne *r1
+cmp L53, r7
+jsr L37
+L8: bne L64
+m1
+mov r3, *r4
+L9: mov #-112, r2
+mov *r7, L44
+mov #-2005, r4
+L10: .data 2828, -2331, 9218, 1668, -14478
+clr r5
+bne L30
+L11: stop
+cmp #-1458, L34
+.string "gigiooqw"
+L12: cmp r6, L23
+stop
+.string "z"
+L13: not X6
+not *r2
+rts
+L14: clr L58
+prn L46
+red L32
+L15: jmp L51
+jsr r7
+m4
+L16: clr r0
+stop
+.data 15145, -7912, -8518
+L17: jsr L21
+cmp *r4, r7
+m4
+L18: lea L3, r0
+mov *r4, L78
+lea L5, L83
+L19: mov #-1826, *r2
+prn L72
+dec r6
+L20: stop
+stop
+.data 12494, 12189, -5866, -3506, -13585, -10228
+L21: jsr #-297
+dec L53
+dec L20
+L22: prn *r5
+stop
+.data -13378
+L23: jsr r6
+cmp *r4, *r0
+red L4
+L24: not r4
+clr L0
+red L38
+L25: mov #-222, *r6
+lea L2, r2
+add *r0, r2
+L26: jsr r6
+jsr r4
+red *r1
+L27: inc L94
+inc L65
+add *r3, X9
+L28: lea L21, L15
+add #-96, X4
+m3
+L29: rts
+.data -3983, 4732
+.data -16057, 13177
+L30: jsr r3
+stop
+lea X2, r2
+L31: jmp *r6
+red L15
+jsr L84
+L32: jmp r0
+dec r5
+add #29, X2
+L33: prn r4
+not *r3
+m4
+L34: .string "ustvopbtwuml"
+.data -11577, -15022, -7934, -13998
+m7
+L35: sub #1298, *r7
+stop
+sub #1497, *r3
+L36: .data 15774, -4014
+inc L83
+sub *r0, *r7
+L37: stop
+m5
+dec r0
+L38: add r2, L63
+stop
+jsr #-731
+L39: .string "jwpcyvy"
+.data -8676, -3546, -13609, -8805, 12584, 1087
+m7
+L40: .data -5418, 9202, -4319
+jsr r4
+.data -5133, -792
+L41: sub L81, *r2
+rts
+m0
+L42: jmp L49
+sub #-396, L64
+dec r4
+L43: red L47
+clr r3
+add #-811, *r5
+L44: jsr X5
+jsr r0
+.data -8247, -9104
+L45: inc *r6
+jmp r6
+.string "pykca"
+L46: clr *r4
+add r0, *r0
+red L59
+L47: mov r6, *r5
+inc *r4
+.data -8548, -9574, -14896, -6994, 2076
+L48: bne *r2
+inc L86
+sub *r5, L83
+L49: not *r3
+lea L69, r0
+.string "ebxu"
+L50: .data -13043, 13341, 1066, 5041
+m1
+jsr L40
+L51: .string "iwgdrxg"
+dec *r1
+jmp *r6
+L52: bne L73
+clr *r0
+stop
+L53: jmp *r2
+.data 10537, -3542, -10314, 5692
+.data 8018, 9477, -3961, -9641, 15115
+L54: not *r6
+m4
+inc *r7
+L55: cmp *r1, #-1142
+not L40
+prn r4
+L56: jsr *r5
+.data 13741
+rts
+L57: cmp *r6, r2
+add #1683, L25
+bne *r3
+L58: .data -16186, -6977, -3732, -8798, -4068
+cmp L42, L20
+add #1980, *r1
+L59: red L19
+inc *r6
+prn *r6
+L60: clr r0
+mov #-280, *r5
+not r5
+L61: dec r1
+jsr L89
+stop
+L62: clr r4
+.data -11921, 5453, -1859, 9216
+.data -4577, -10909, 11469, 9234, 5675, 8185
+L63: jsr *r0
+rts
+add L5, *r1
+L64: bne L37
+red L99
+jsr L36
+L65: prn r6
+clr r7
+lea L83, *r3
+L66: sub r7, *r3
+bne *r1
+cmp *r1, r0
+L67: not r3
+jsr *r6
+bne L46
+L68: prn L8
+m1
+add L45, r6
+L69: rts
+bne L60
+mov L93, L77
+L70: .string "kl"
+jsr r1
+inc L39
+L71: lea L99, r3
+cmp #318, *r2
+jsr L13
+L72: red *r5
+inc L14
+jmp L32
+L73: not r6
+.data 10052, 3645
+.string "huoj"
+L74: prn X5
+clr L51
+.data -15656, 11023, -8107, -15701, -6811
+L75: lea L82, r1
+clr L78
+rts
+L76: .data -12713, -10467, 8604, 657, -7642, 4178
+inc *r0
+clr *r5
+L77: .data 5191, -14901, -7989, -5559, 3937, -11281
+not r4
+red X0
+L78: clr *r4
+inc *r0
+prn r6
+L79: .string ""
+.data -14163, -8468, 6394, -6788
+inc r0
+L80: .data -1352
+rts
+.data 2556
+L81: inc L83
+jmp r3
+mov *r1, *r2
+L82: rts
+.string "aswoyvjrsrj"
+red *r2
+L83: inc *r4
+cmp *r2, *r6
+cmp *r2, L41
+L84: cmp #-183, #254
+sub L66, *r5
+clr L72
+L85: inc r3
+inc L89
+.string "tyctmeqh"
+L86: jmp L52
+.string "nlkaycxzlm"
+prn *r0
+L87: .string "fqycdhoksw"
+.data -13461
+jsr L57
+L88: prn *r2
+clr L20
+lea L0, L78
+L89: red L78
+sub #-1007, r4
+jsr #-1061
+L90: not L57
+not *r0
+stop
+L91: prn X2
+add #-25, r0
+dec L74
+L92: add #303, L79
+rts
+inc L52
+L93: .data -2220, 16062, -5214
+.data 416, 364, 15518, -8293, 14109
+.string "mskawhiu"
+L94: sub *r6, L93
+red *r5
+m3
+L95: bne L15
+rts
+stop
+L96: cmp r0, X7
+red *r4
+jmp r7
+L97: bne L50
+jmp r5
+jmp r7
+L98: red *r5
+.data 531
+jmp L96
+L99: jmp r3
+.string "pzjp"
+jmp L56
+.entry L0
+.entry L10
+.entry L20
+.entry L30
+.entry L40
+.entry L50
+.entry L60
+.entry L70
+.entry L80
+.entry L90
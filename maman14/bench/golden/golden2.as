@@ -0,0 +1,442 @@
+.extern X0
+.extern X1
+.extern X2
+.extern X3
+.extern X4
+.extern X5
+.extern X6
+.extern X7
+.extern X8
+.extern X9
+.extern X10
+.extern X11
+.extern X12
+.extern X13
+.extern X14
+.extern X15
+.extern X16
+.extern X17
+.extern X18
+.extern X19
+.extern X20
+.extern X21
+.extern X22
+.extern X23
+macr m0
+ jsr r0
+ mov X0, r4
+ add L59, r2
+endmacr
+macr m1
+ prn *r4
+ clr r6
+ dec L58
+endmacr
+macr m2
+ prn *r0
+ sub r4, r4
+ jmp *r6
+endmacr
+macr m3
+ dec r4
+ jsr L37
+ bne L35
+endmacr
+macr m4
+ jsr #57
+ dec *r6
+ not *r4
+endmacr
+macr m5
+ dec *r7
+ jmp *r7
+ add *r2, *r0
+endmacr
+macr m6
+ inc *r0
+ clr r6
+ add L27, r3
+endmacr
+macr m7
+ stop
+ not L44
+ stop
+endmacr
+macr m8
+ cmp *r4, r1
+ inc r2
+ add r1, L31
+endmacr
+macr m9
+ prn X7
+ clr r0
+ bne X0
+endmacr
+macr m10
+ red *r6
+ lea L0, L49
+ stop
+endmacr
+macr m11
+ cmp r5, r3
+ cmp r7, #-44
+ not L4
+endmacr
+macr m12
+ mov r2, L29
+ rts
+ not L19
+endmacr
+macr m13
+ stop
+ mov X21, L1
+ jmp X1
+endmacr
+macr m14
+ lea L34, *r0
+ clr L16
+ inc r4
+endmacr
+macr m15
+ not *r2
+ sub *r4, *r7
+ add *r3, L4
+endmacr
+macr m16
+ inc L37
+ dec r4
+ jmp r2
+endmacr
+macr m17
+ bne *r7
+ stop
+ stop
+endmacr
+macr m18
+ red *r6
+ inc *r7
+ jsr r4
+endmacr
+macr m19
+ cmp *r3, r5
+ not *r7
+ stop
+endmacr
+L0: jsr r3
+.string "oey"
+.string "hf"
+.data 12352, -4073, -5936, -9079
+.data 12098, -551, -797, 2314
+L1: add L20, X8
+jmp *r7
+.data -16377
+rts
+lea L4, *r2
+L2: .data 3637, 6951, -5076, 4422
+.data -6192, -4695, -9829, 5921
+.string "ehchmx"
+.string "zmrq"
+dec L40
+L3: .data 1983
+inc r1
+clr L23
+jmp *r0
+rts
+L4: clr X17
+rts
+.string "ys"
+cmp #-1558, r6
+not L56
+L5: not L43
+.string "modpkouc"
+mov *r0, *r3
+.data 1207, -12296, -3885, -10490, -3334, 13789
+.string ""
+L6: prn r0
+.string "wuaskskqndrk"
+red *r5
+prn L25
+.data -10578
+L7: lea X13, r0
+inc *r7
+.string "ttbtujzv"
+.data 2021, -13306
+inc *r0
+L8: red *r7
+bne L41
+add *r2, *r7
+jmp *r5
+.string "ghwzw"
+L9: lea L41, *r6
+.data 6154
+.string "t"
+.data 7169, -2226, 12862, 1958, 7564, -1188
+stop
+L10: .string "shctoyvit"
+red L2
+.data 9278, -10379, 13261, -11834, -3797, 8585
+not r2
+bne L45
+L11: add #202, r1
+.data -4185, -14796, -6454
+m10
+cmp *r5, *r7
+dec *r1
+L12: sub r3, r1
+not r6
+dec *r6
+jsr r0
+dec *r5
+L13: .data 7323, -3955, 13476
+red X6
+jmp L28
+add L43, *r5
+.string "nsqhbn"
+L14: .data 11571, -8607, 1675
+not *r6
+bne X17
+lea L47, *r3
+.data -9457, 8833
+L15: .data 6089, -10841, -3323, 12197, -4902, 8874
+.string "konyzjm"
+sub L29, *r3
+.data 27, -6329, 3726, -15917, 4407, 14866
+.string "kdgbrkq"
+L16: .string "bupwmtkmuqn"
+add #-1747, L19
+.data -15453, -10433, -5282, -13734, -14794, -8627
+inc L32
+dec X1
+L17: jmp *r0
+clr L39
+.data -2913, 5604, -10175, -16027, -10813
+.data 8317
+inc r5
+L18: mov *r2, *r4
+jmp L47
+red *r5
+.data -5560, -4791, 7216, -7377
+mov L28, r6
+L19: not r7
+.data 14164, -386, -15243, -12064
+jmp *r4
+.data -2498, 8861, -6252, -13043, -12553, -3242
+.string "rhnlokhnm"
+L20: jmp r5
+.data 4845
+clr *r5
+stop
+lea L50, *r6
+L21: .data 2976, -9178, 4781
+.data 13625, -8385
+sub r1, L55
+rts
+prn r3
+L22: stop
+prn r5
+.data -11409, -6193, 6910, -9992, 16021
+prn r6
+lea L32, *r4
+L23: stop
+dec *r2
+.string ""
+dec *r4
+.string "xvkv"
+L24: .string "nlrschususw"
+mov #-926, L17
+bne L25
+sub *r2, r7
+lea L14, *r2
+L25: rts
+add *r1, L16
+mov L36, *r7
+m1
+add X16, L37
+L26: cmp r3, r0
+jmp r4
+.data 8892, 15058
+prn *r6
+.data 2033, -11028, 11621, -7170, 4048, 39
+L27: .string "ucwgjljq"
+m8
+mov L58, r0
+add r7, *r2
+.string ""
+L28: jsr L53
+prn *r2
+jsr #485
+inc r2
+sub #755, *r1
+L29: cmp *r2, r0
+.data 8364, -10677, -5909, 5004
+stop
+prn X0
+.data -14978
+L30: .data 4307, -10002
+add #353, r2
+clr *r0
+.data -16081, -7649, -14560, 7275, -4400
+mov *r2, r0
+L31: jmp L50
+stop
+.data -12571, 4964, -10148, -218, 2026
+.data -8056, 6708, 14790, -9821, 7301
+.data 1982, 8474, -2682, 7022, 14884, -16381
+L32: .data -13631, 10939, -454, -1474, -14783
+mov r7, r2
+dec r5
+dec r5
+.data 11254, -4962, 7879, 14093, -6471, -15765
+L33: .data -3921, 5569, -2141, 2428, -5802, 5740
+m1
+inc r6
+mov r5, X17
+jsr r1
+L34: inc X15
+dec *r5
+.data -8517
+.string ""
+bne *r1
+L35: red L9
+.data 10261, -5564, -15791, 10973, 14784, 6160
+.data -8025, 1228, 10543
+not *r4
+jmp r0
+L36: stop
+add *r6, r2
+bne *r2
+.data -14768, 691, -6215, -5987, -2972, -2584
+red L15
+L37: not *r3
+red *r2
+rts
+jmp r0
+.string "nzlaqxxnt"
+L38: .string "m"
+mov #42, r7
+clr L57
+sub #-907, *r7
+clr r6
+L39: rts
+lea L40, L49
+red *r4
+.data -4742, 5743, 11040
+red *r3
+L40: prn *r6
+sub L43, *r1
+prn L55
+red *r6
+add r4, r5
+L41: sub *r7, L36
+prn r0
+stop
+clr X1
+stop
+L42: not X6
+.string "pj"
+bne L31
+add L41, *r3
+add *r5, r2
+L43: .string "n"
+dec *r6
+.string "kuumnqg"
+add r5, r3
+stop
+L44: not L17
+not r4
+.string "c"
+mov *r6, *r6
+red X12
+L45: .data -13510, -9991, 13560, -9064
+clr *r2
+mov #1304, r0
+inc r6
+rts
+L46: rts
+jsr L39
+.data 14755, 1858, 3731
+bne X13
+rts
+L47: .data 4325, -11110, 14225, 1921
+mov r2, r7
+bne *r5
+jsr *r2
+rts
+L48: clr L46
+add #830, r4
+not *r0
+jsr *r2
+mov *r6, L43
+L49: stop
+.data -5974, 7074, -6184
+prn r6
+.string "bg"
+.string "cdkjqfotk"
+L50: .string "cnvydjslzq"
+m7
+cmp *r4, r1
+m16
+.data 1878, -12753, 13965
+L51: bne *r0
+clr X6
+.data -14061, -5434, -3180
+.string "vond"
+lea L59, *r3
+L52: add #672, *r2
+jmp r4
+lea L16, *r7
+mov #-1849, X6
+clr L52
+L53: rts
+sub #-1618, L35
+cmp #-1260, L27
+.data -10634, 703
+inc L34
+L54: add *r7, *r5
+.string "kstr"
+inc r1
+.string "lxpbndoomjq"
+jmp r3
+L55: .string "jtvuzfjrxit"
+m18
+.data -7630, 7477
+m5
+lea L14, *r5
+L56: dec L44
+mov L20, X7
+cmp r3, *r6
+jmp *r3
+lea L5, L41
+L57: lea X8, L59
+.data 10715
+.string "zt"
+m16
+jmp r7
+L58: clr *r6
+mov L13, X19
+.string ""
+.data -14598, -16277, -3644, -6891, -14836, 15835
+prn L32
+L59: bne *r7
+dec L4
+cmp #664, L54
+.data -7787, 3738, 2505, 15696, 5657, 4371
+dec r1
+.entry L0
+.entry L3
+.entry L6
+.entry L10
+.entry L13
+.entry L16
+.entry L20
+.entry L23
+.entry L26
+.entry L30
+.entry L33
+.entry L36
+.entry L40
+.entry L43
+.entry L46
+.entry L50
+.entry L53
+.entry L56
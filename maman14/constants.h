@@ -16,5 +16,11 @@
 #define MAX_SYMBOL_NAME_LENGTH 31
 #define NOT_FOUND_SYMBOL -1
 
+/* The work is spread over threads when the platform has POSIX threads and the compiler has
+ * atomic builtins, otherwise everything runs on one thread*/
+#if (defined(__unix__) || defined(__APPLE__)) && defined(__GNUC__)
+#define USE_THREADS
+#endif
+
 
 #endif /*CONSTANTS_H*/
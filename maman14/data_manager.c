@@ -2,13 +2,15 @@
 
 /**
  * handle_numbers -
- * Converts an array of number strings into an array of 15-bit two's complement representations.
+ * Converts an array of number strings into an array of 15-bit two's complement words.
  *
  * @param number_strings An array of strings where each string represents a number.
- * @return A new array of strings representing the 15-bit two's complement of each number. Returns NULL if memory allocation fails.
+ * @param word_count Set to the number of words in the returned array.
+ * @param allocator The allocator the array is taken from, the caller releases it there.
+ * @return A new array of the 15-bit two's complement word of each number. Returns NULL if a number is invalid or memory allocation fails.
  */
-char** handle_numbers(char** number_strings) {
-	char** result;
+Word* handle_numbers(char** number_strings, int* word_count, Allocator* allocator) {
+	Word* result;
 	int count = 0;
 	int i, j;
 
@@ -17,8 +19,8 @@ char** handle_numbers(char** number_strings) {
 		count++;
 	}
 
-	/* Allocate memory for the result array, including space for the null terminator */
-	result = (char**)malloc((count + 1) * sizeof(char*));
+	/* Allocate memory for the result array, at least one word so an empty .data is not mistaken for a failure */
+	result = (Word*)allocate_memory(allocator, (count + 1) * sizeof(Word));
 	if (result == NULL) {
 		log_error("handle_numbers", 23, "data_manager.c", "Memory allocation failed");
 		return NULL;
@@ -30,7 +32,7 @@ char** handle_numbers(char** number_strings) {
 		/* Check if the first character is a '+' or '-', or a digit */
 		if (current_string[0] != '+' && current_string[0] != '-' && !isdigit(current_string[0])) {
 			log_error("handle_numbers", 31, "data_manager.c", "Invalid number format (must start with '+', '-', or a digit)");
-			free(result);
+			release_memory(allocator, result);
 			return NULL;
 		}
 
@@ -38,98 +40,89 @@ char** handle_numbers(char** number_strings) {
 		for (j = 1; current_string[j] != '\0'; j++) {
 			if (!isdigit(current_string[j])) {
 				log_error("handle_numbers", 40, "data_manager.c", "Invalid number format (must contain only digits after the optional sign)");
-				free(result);
+				release_memory(allocator, result);
 				return NULL;
 			}
 		}
 
-		/* Convert the string to an integer and generate its 15-bit two's complement representation */
-		int number = atoi(current_string);
-		result[i] = int_to_15bit_twos_complement(number);
+		/* Convert the string to an integer and generate its 15-bit two's complement word */
+		result[i] = int_to_15bit_twos_complement(atoi(current_string));
+		if (result[i] == NO_WORD) {
+			label_error("handle_numbers", 50, "data_manager.c", "Number is out of range", current_string);
+			release_memory(allocator, result);
+			return NULL;
+		}
 	}
 
-	/* Null-terminate the result array */
-	result[count] = NULL;
-
+	*word_count = count;
 	return result;
 }
 
 
 /**
  * handle_strings -
- * Converts an input string into an array of 15-bit ASCII representations of its characters.
+ * Converts an input string into an array of the 15-bit ASCII words of its characters.
  *
- * @param input_string The input string, which must be enclosed in quotation marks.
- * @return A new array of strings representing the 15-bit ASCII of each character in the input string,
- *         followed by a string of 15 "0"s. Returns NULL if memory allocation fails or if the input is invalid.
+ * @param input_string The input string, which must be enclosed in quotation marks. NULL if the line has none.
+ * @param word_count Set to the number of words in the returned array.
+ * @param allocator The allocator the array is taken from, the caller releases it there.
+ * @return A new array of the 15-bit ASCII word of each character in the input string,
+ *         followed by a 0 word. Returns NULL if memory allocation fails or if the input is invalid.
  */
-char** handle_strings(const char* input_string) {
+Word* handle_strings(const char* input_string, int* word_count, Allocator* allocator) {
 	int length, i;
-	char** result;
-	char* trimmed;
-	int extra_length;
-	char* zero_string;
-
-	if (!is_first_char_quotation(input_string)) {
-		label_error("handle_strings", 74, "data_manager.c", "string is not valid", input_string);
+	Word* result;
 
+	if (input_string == NULL) {
+		log_error("handle_strings", 75, "data_manager.c", "Missing string operand");
 		return NULL;
 	}
-	else {
-		trimmed = remove_first_last(input_string);
-		if (trimmed == NULL) {
-			label_error("handle_strings", 61, "assembler_manager.c", "string is not valid", input_string);
-			return NULL;
-		}
 
-		extra_length = 1;  /* Additional slot for the 15 "0"s string*/
+	if (!is_first_char_quotation(input_string)) {
+		label_error("handle_strings", 80, "data_manager.c", "string is not valid", input_string);
 
+		return NULL;
+	}
 
-		length = strlen(trimmed);
-		result = (char**)malloc((length + extra_length) * sizeof(char*));
-		if (result == NULL) {
-			log_error("handle_strings", 71, "data_manager.c", "Memory allocation failed");
-			return NULL;
-		}
+	/* The characters between the quotation marks*/
+	length = strlen(input_string);
+	length = length > 2 ? length - 2 : 0;
 
-		for (i = 0; i < length; i++) {
-			result[i] = letter_to_15bit_ascii(trimmed[i]);
-		}
+	result = (Word*)allocate_memory(allocator, (length + 1) * sizeof(Word)); /* Additional slot for the 0 word*/
+	if (result == NULL) {
+		log_error("handle_strings", 91, "data_manager.c", "Memory allocation failed");
+		return NULL;
+	}
 
-		/* Add the "000000000000000" string to the end of the result*/
-		zero_string = (char*)malloc((WORD_SIZE_IN_BITS + 1) * sizeof(char));  /* 15 "0"s + NULL terminator*/
-		if (zero_string == NULL) {
-			log_error("handle_strings", 82, "data_manager.c", "Memory allocation failed");
-			return NULL;
-		}
-		memset(zero_string, '0', WORD_SIZE_IN_BITS);  /* Fill with "0"s*/
-		zero_string[WORD_SIZE_IN_BITS] = '\0';        /* Null-terminate the string*/
-		result[length] = zero_string;
+	for (i = 0; i < length; i++) {
+		result[i] = letter_to_15bit_ascii(input_string[i + 1]);
+	}
 
-		result[length + 1] = NULL;  /* NULL-terminate the array*/
+	/* Add the 0 word to the end of the result*/
+	result[length] = 0;
 
-		free(trimmed);  /* Free the trimmed string if it was dynamically allocated*/
-		return result;
-	}
+	*word_count = length + 1;
+	return result;
 }
 
 
 /**
  * generateDataLine -
- * Generates an array of strings based on the type of data specified in the input array.
+ * Generates the words of the data of a data line.
  *
- * @param input_array An array of strings where the first element is a directive (e.g., ".data") and
- *                    subsequent elements contain the data to process.
- * @return A new array of strings representing processed data. If the directive is `.data`, it returns
+ * @param parsed The data line, as built by build_line, its arguments contain the data to process.
+ * @param word_count Set to the number of words in the returned array.
+ * @param allocator The allocator the array is taken from, the caller releases it there.
+ * @return A new array of words representing the data. If the directive is `.data`, it returns
  *         the result of `handle_numbers`. If it is a string, it returns the result of `handle_strings`.
  *         Returns NULL if memory allocation fails or if an error occurs.
  */
-char** generateDataLine(char** input_array) {
-	if (strcmp(input_array[0], ".data") == 0) {
-		return handle_numbers(input_array + 1);
+Word* generateDataLine(const ParsedLine* parsed, int* word_count, Allocator* allocator) {
+	if (parsed->type == DataLine) {
+		return handle_numbers(parsed->arguments, word_count, allocator);
 	}
 	else {
-		return handle_strings(input_array[1]);
+		return handle_strings(parsed->arguments[0], word_count, allocator);
 
 	}
 }
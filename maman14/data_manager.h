@@ -9,12 +9,14 @@
 
 #include "strings_manager.h"
 #include "number_manager.h"
+#include "line_builder.h"
 #include "constants.h"
 #include "error_manager.h"
+#include "memory_manager.h"
 
-char** handle_numbers(char** number_strings);
-char** handle_strings(const char* input_array);
-char** generateDataLine(char** input_array);
+Word* handle_numbers(char** number_strings, int* word_count, Allocator* allocator);
+Word* handle_strings(const char* input_array, int* word_count, Allocator* allocator);
+Word* generateDataLine(const ParsedLine* parsed, int* word_count, Allocator* allocator);
 
 #endif /*DATA_MANAGER_H*/
 
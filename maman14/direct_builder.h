@@ -11,10 +11,10 @@
 #include "error_manager.h"
 
 /* Function to generate the ARE bits for a direct addressing line*/
-char* direct_are(int num);
+Word direct_are(int num);
 
 /* Function to generate a complete direct addressing line*/
-char* generate_direct_line(int num);
+int generate_direct_line(Word* slot, int num);
 
 #endif /* DIRECT_BUILDER_H*/
 
@@ -1,5 +1,138 @@
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
 #include "error_manager.h"
 
+#ifdef USE_THREADS
+#include <pthread.h>
+
+/* Every thread has its own log, the threads of a file share the file's log*/
+static pthread_key_t error_log_key;
+static pthread_once_t error_log_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t error_log_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * create_error_log_key -
+ * Creates the key of the threads' logs, once.
+ */
+static void create_error_log_key(void) {
+	pthread_key_create(&error_log_key, NULL);
+}
+#else
+static ErrorLog* current_error_log = NULL;
+#endif
+
+/**
+ * set_error_log -
+ * Sets where the errors of the calling thread go.
+ *
+ * @param log The log that keeps the errors, or NULL to print them to stderr right away.
+ */
+void set_error_log(ErrorLog* log) {
+#ifdef USE_THREADS
+	pthread_once(&error_log_once, create_error_log_key);
+	pthread_setspecific(error_log_key, log);
+#else
+	current_error_log = log;
+#endif
+}
+
+/**
+ * get_error_log -
+ * Gives where the errors of the calling thread go.
+ *
+ * @return The log that keeps the errors, or NULL if they are printed to stderr right away.
+ */
+ErrorLog* get_error_log(void) {
+#ifdef USE_THREADS
+	pthread_once(&error_log_once, create_error_log_key);
+	return (ErrorLog*)pthread_getspecific(error_log_key);
+#else
+	return current_error_log;
+#endif
+}
+
+/**
+ * init_error_log -
+ * Initializes an empty log, no memory is taken until the first error.
+ *
+ * @param log Pointer to the ErrorLog to initialize.
+ */
+void init_error_log(ErrorLog* log) {
+	log->text = NULL;
+	log->length = 0;
+	log->size = 0;
+}
+
+/**
+ * print_error_log -
+ * Prints the errors kept in a log and releases it.
+ *
+ * @param log Pointer to the ErrorLog to print.
+ * @param file The file to print to.
+ */
+void print_error_log(ErrorLog* log, FILE* file) {
+	if (log->length > 0) {
+		fwrite(log->text, 1, log->length, file);
+	}
+	free(log->text);
+	init_error_log(log);
+}
+
+/**
+ * report_error -
+ * Prints an error, or keeps it in the log of the calling thread.
+ *
+ * @param function The name of the function where the error occurred.
+ * @param line The line number in the source code where the error occurred.
+ * @param file The name of the source code file where the error occurred.
+ * @param message The error message.
+ * @param detail The file path or label the error is about, or NULL.
+ */
+static void report_error(const char* function, int line, const char* file, const char* message, const char* detail) {
+	ErrorLog* log = get_error_log();
+	size_t needed;
+
+	if (log != NULL) {
+		needed = strlen(function) + strlen(file) + strlen(message) + (detail != NULL ? strlen(detail) : 0) + ERROR_FORMAT_LENGTH;
+#ifdef USE_THREADS
+		pthread_mutex_lock(&error_log_lock);
+#endif
+		if (log->length + needed > log->size) {
+			size_t new_size = log->size * 2 > log->length + needed ? log->size * 2 : log->length + needed;
+			char* new_text = (char*)realloc(log->text, new_size);
+			if (new_text != NULL) {
+				log->text = new_text;
+				log->size = new_size;
+			}
+		}
+		if (log->length + needed <= log->size) {
+			if (detail != NULL) {
+				log->length += sprintf(log->text + log->length, "Error in function %s at line %d in file %s: %s: %s\n", function, line, file, message, detail);
+			}
+			else {
+				log->length += sprintf(log->text + log->length, "Error in function %s at line %d in file %s: %s\n", function, line, file, message);
+			}
+			log = NULL;
+		}
+#ifdef USE_THREADS
+		pthread_mutex_unlock(&error_log_lock);
+#endif
+		if (log == NULL) {
+			return;
+		}
+		/* No memory to keep the error, print it now*/
+	}
+
+	if (detail != NULL) {
+		fprintf(stderr, "Error in function %s at line %d in file %s: %s: %s\n", function, line, file, message, detail);
+	}
+	else {
+		fprintf(stderr, "Error in function %s at line %d in file %s: %s\n", function, line, file, message);
+	}
+}
+
 /**
  * log_error Logs an error message with detailed information about the location of the error.
  *
@@ -9,7 +142,7 @@
  * @param message The error message describing the nature of the error.
  */
 void log_error(const char* function, int line, const char* file, const char* message) {
-   fprintf(stderr, "Error in function %s at line %d in file %s: %s\n", function, line, file, message);
+   report_error(function, line, file, message, NULL);
 }
 
 /**
@@ -23,7 +156,7 @@ void log_error(const char* function, int line, const char* file, const char* mes
  * @param file_path The path of the file involved in the error, providing additional context.
  */
 void file_error(const char* function, int line, const char* file, const char* message, const char* file_path) {
-   fprintf(stderr, "Error in function %s at line %d in file %s: %s: %s\n", function, line, file, message, file_path);
+   report_error(function, line, file, message, file_path != NULL ? file_path : "(null)");
 }
 
 /**
@@ -37,7 +170,7 @@ void file_error(const char* function, int line, const char* file, const char* me
  * @param label_name The name of the label involved in the error, providing additional context.
  */
 void label_error(const char* function, int line, const char* file, const char* message, const char* label_name) {
-	fprintf(stderr, "Error in function %s at line %d in file %s: %s: %s\n", function, line, file, message, label_name);
+	report_error(function, line, file, message, label_name != NULL ? label_name : "(null)");
 }
 
 
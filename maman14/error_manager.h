@@ -7,7 +7,21 @@
 
 #include "constants.h"
 
+#define ERROR_FORMAT_LENGTH 64 /* The fixed text of an error and the digits of its line*/
+
+/* The errors of one file, kept until they can be printed after the errors of the files before it*/
+typedef struct {
+	char* text;
+	size_t length;
+	size_t size;
+} ErrorLog;
+
 void log_error(const char* function, int line, const char* file, const char* message);
 void file_error(const char* function, int line, const char* file, const char* message, const char* file_path);
 void label_error(const char* function, int line, const char* file, const char* message, const char* label_name);
+
+void init_error_log(ErrorLog* log);
+void set_error_log(ErrorLog* log);
+ErrorLog* get_error_log(void);
+void print_error_log(ErrorLog* log, FILE* file);
 #endif /* ERROR_MANAGER_H*/
@@ -5,34 +5,166 @@
  * Initializes the FileManager structure.
  *
  * @param manager Pointer to the FileManager structure to be initialized.
+ * @param allocator The allocator that owns the FileManager's memory.
  */
-void initialize_file_manager(FileManager* manager) {
-	/* Set the post_macro pointer to NULL, indicating no macro has been processed yet. */
-	manager->post_macro = NULL;
+void initialize_file_manager(FileManager* manager, Allocator* allocator) {
+	manager->allocator = allocator;
+	/* Nothing was read yet, the pool is allocated once the size of the input is known. */
+	manager->pool = NULL;
+	manager->pool_used = 0;
+	manager->pool_size = 0;
+	manager->tokens = NULL;
+	manager->token_count = 0;
+	manager->token_size = 0;
+	manager->lines = NULL;
 	/* Initialize the row count to 0, meaning no rows have been processed yet. */
 	manager->row_count = 0;
+	manager->line_size = 0;
+	manager->queue = NULL;
+	manager->source_lines = 0;
+	manager->source_tokens = 0;
+	manager->macro_expansions = 0;
+}
 
+/**
+ * add_line -
+ * Adds a line, whose tokens are already in the tokens array, to the lines index.
+ *
+ * @param manager Pointer to the FileManager structure.
+ * @param first_token The index in tokens of the first token of the line.
+ * @return FOUND if the line was added, NOT_FOUND if memory allocation failed.
+ */
+static int add_line(FileManager* manager, int first_token) {
+	if (manager->row_count == manager->line_size) {
+		int new_size = manager->line_size ? manager->line_size * 2 : LINES_INITIAL_SIZE;
+		int* new_lines = (int*)resize_memory(manager->allocator, manager->lines, new_size * sizeof(int));
+		if (new_lines == NULL) {
+			log_error("add_line", 74, "file_manager.c", "Memory allocation failed");
+			return NOT_FOUND;
+		}
+		manager->lines = new_lines;
+		manager->line_size = new_size;
+	}
+	manager->lines[manager->row_count] = first_token;
+	manager->row_count++;
+	if (manager->queue != NULL) {
+		line_queue_push(manager->queue, manager->tokens + first_token);
+	}
+	return FOUND;
 }
 
 /**
- * free_file_manager -
- * Frees the memory allocated for the FileManager structure.
+ * get_post_macro_line -
+ * Returns a line of the post-macro program.
  *
- * @param manager Pointer to the FileManager structure whose memory is to be freed.
+ * @param manager Pointer to the FileManager structure.
+ * @param row The index of the line.
+ * @return A NULL-terminated array of the line's tokens.
  */
-void free_file_manager(FileManager* manager) {
-	int i, j;
-	/* Iterate over each row in the post_macro array. */
-	for (i = 0; i < manager->row_count; ++i) {
-		/* Iterate over each string in the current row and free it. */
-		for (j = 0; manager->post_macro[i][j] != NULL; ++j) {
-			free(manager->post_macro[i][j]);
+char** get_post_macro_line(const FileManager* manager, int row) {
+	return manager->tokens + manager->lines[row];
+}
+
+/**
+ * get_post_macro_line_length -
+ * Returns the number of tokens in a line of the post-macro program.
+ *
+ * @param manager Pointer to the FileManager structure.
+ * @param row The index of the line.
+ * @return The number of tokens in the line.
+ */
+int get_post_macro_line_length(const FileManager* manager, int row) {
+	/* Each line ends with a NULL token, lines of a macro are shared by all of its expansions*/
+	char** line = manager->tokens + manager->lines[row];
+	int length = 0;
+	while (line[length] != NULL) length++;
+	return length;
+}
+
+/**
+ * expand_source -
+ * Tokenizes a source and expands its macros into the FileManager's post-macro table.
+ * The source is left open, the table does not refer to it.
+ *
+ * @param fileManager A pointer to the FileManager structure that will be updated with
+ *                     the processed data from the source.
+ * @param macroManager A pointer to the MacroManager structure used to check for macros
+ *                      and retrieve their content.
+ * @param source The opened source to expand.
+ * @return FOUND if the macros were expanded, NOT_FOUND otherwise.
+ */
+int expand_source(FileManager* fileManager, MacroManager* macroManager, SourceManager* source) {
+	int i, split_count, first_token;
+	long pool_mark;
+	char** split_line;
+	const Macro* macro;
+
+	/* Every token is followed by a separator or by the end of the file in the source,
+	 * and every line by a newline or by the end of the file, so a token and its null terminator
+	 * or a line's NULL take no more room than the source: the pool and the tokens array are
+	 * allocated once and never move*/
+	fileManager->pool_size = source->length + 1;
+	fileManager->pool = (char*)allocate_memory(fileManager->allocator, fileManager->pool_size);
+	fileManager->token_size = (int)fileManager->pool_size;
+	fileManager->tokens = (char**)allocate_memory(fileManager->allocator, fileManager->token_size * sizeof(char*));
+	if (fileManager->pool == NULL || fileManager->tokens == NULL) {
+		log_error("expand_source", 108, "file_manager.c", "Memory allocation failed");
+		return NOT_FOUND;
+	}
+
+	/*Tokenize the source line by line in place*/
+	while (next_source_line(source)) {
+		split_count = source->span_count;
+		fileManager->source_lines++;
+		fileManager->source_tokens += split_count;
+
+		/* Copy the tokens of the line into the pool */
+		first_token = fileManager->token_count;
+		pool_mark = fileManager->pool_used;
+		for (i = 0; i < split_count; i++) {
+			char* token = fileManager->pool + fileManager->pool_used;
+			memcpy(token, source->data + source->spans[i].offset, source->spans[i].length);
+			token[source->spans[i].length] = '\0';
+			fileManager->pool_used += source->spans[i].length + 1;
+			fileManager->tokens[fileManager->token_count++] = token;
+		}
+		fileManager->tokens[fileManager->token_count++] = NULL;
+		split_line = fileManager->tokens + first_token;
+
+		/* Check if the first token is a macro name */
+		macro = split_count > 0 ? find_macro(macroManager, *split_line) : NULL;
+		if (macro != NULL)
+		{
+			/* The invocation itself is not part of the program */
+			fileManager->macro_expansions++;
+			fileManager->token_count = first_token;
+			fileManager->pool_used = pool_mark;
+
+			/* The macro's lines are already in the tokens array, only the lines index grows */
+			for (i = 0; i < macro->row_count; i++) {
+				if (!add_line(fileManager, (int)macro->lines[i])) {
+					return NOT_FOUND;
+				}
+			}
+		}
+		else {
+			/* Process the line normally if it is not a macro name */
+			LineKind kind = process_file_line(macroManager, split_line, split_count, first_token);
+			if (kind == ProgramLine) {
+				/* The line is part of the program, add it to the post_macro table */
+				if (!add_line(fileManager, first_token)) {
+					return NOT_FOUND;
+				}
+			}
+			else if (kind == SkippedLine) {
+				/* Empty line, start or end of a macro definition, its tokens are not kept */
+				fileManager->token_count = first_token;
+				fileManager->pool_used = pool_mark;
+			}
+			/* The tokens of a MacroLine stay in place, the macro refers to them */
 		}
-		/* Free the memory allocated for the current row. */
-		free(manager->post_macro[i]);
 	}
-	/* Free the memory allocated for the post_macro array itself. */
-	free(manager->post_macro);
+	return FOUND;
 }
 
 /**
@@ -48,98 +180,34 @@ void free_file_manager(FileManager* manager) {
  * @return int 0 if the macro file was created successfully otherwise 1
  */
 int input_process(FileManager* fileManager, MacroManager* macroManager, char* file_path) {
-	int i, split_count, len;
-	char** split_line;
-	char line[MAX_LINE_LENGTH];
+	int len, result;
 	char* new_file_path;
-	FILE* file;
+	SourceManager source;
 	/*Concatenate extension string to the name of the file*/
 	len = strlen(file_path) + strlen(INPUT_FILE_EXTENSION) + 1;
 	new_file_path = malloc(len);
 
 	if (new_file_path == NULL) {
-		log_error("input_process", 61, "file_manager.c", "Memory allocation failed");
+		log_error("input_process", 185, "file_manager.c", "Memory allocation failed");
 		return NOT_FOUND;
 	}
 
 	strcpy(new_file_path, file_path);
 	strcat(new_file_path, INPUT_FILE_EXTENSION);
 
-	/* Open the specified file for reading*/
-	file = fopen(new_file_path, "r");
-	if (!file) {
+	/* Map the specified file for reading*/
+	if (!open_source_manager(&source, new_file_path)) {
 		/*Failed to open file*/
-		file_error("input_process", 72, "file_manager.c", "Failed to open file", new_file_path);
+		file_error("input_process", 195, "file_manager.c", "Failed to open file", new_file_path);
+		free(new_file_path);
 		return NOT_FOUND;
 	}
+	free(new_file_path);
 
-	/*File opened*/
-	while (fgets(line, sizeof(line), file)) {
-		/* Remove newline character from the end of the line*/
-		line[strcspn(line, "\n")] = '\0';
-
-		/* Split the line into tokens using whitespace as delimiters */
-		split_line = split_string(line);
-
-		/* Count the number of tokens in the split line */
-		split_count = 0;
-		while (split_line[split_count] != NULL) split_count++;
-
-		/* Check if the first token is a macro name */
-		if (is_macro_name(macroManager, *split_line))
-		{
-			/* Retrieve the content of the macro associated with the macro name */
-			char*** processed_lines = get_macro_content(macroManager, *split_line);
-
-			/* Iterate over each row of the processed macro content */
-			for (i = 0; processed_lines[i] != NULL; i++) {
-				char** row = processed_lines[i];  /* Each row is an array of strings (char**) */
-
-				/* Reallocate memory for the post_macro array to include the new row */
-				fileManager->post_macro = realloc(fileManager->post_macro, (fileManager->row_count + 1) * sizeof(char**));
-				if (fileManager->post_macro == NULL) {
-					/* Handle memory allocation failure */
-					log_error("input_process", 102, "file_manager.c", "Memory allocation failed");
-					return NOT_FOUND;
-				}
-				/* Add the new row to the post_macro array */
-				fileManager->post_macro[fileManager->row_count] = row;
-				/* Increment the row count */
-				fileManager->row_count++;
-			}
-
-		}
-		else {
-			/* Process the line normally if it is not a macro name */
-			char** processed_line = process_file_line(macroManager, split_line, split_count);
-			if (processed_line != NULL) {
-
-				/* Reallocate memory for the post_macro array to include the new line */
-				fileManager->post_macro = realloc(fileManager->post_macro, (fileManager->row_count + 1) * sizeof(char**));
-				if (fileManager->post_macro == NULL) {
-					/* Handle memory allocation failure by logging an error message and exit */
-					log_error("input_process", 121, "file_manager.c", "Memory allocation failed");
-					return NOT_FOUND;
-				}
-
-				/* Add the new line to the post_macro array */
-				fileManager->post_macro[fileManager->row_count] = processed_line;
-				/* Increment the row count */
-				fileManager->row_count++;
-			}
-
-		}
-
-
-		/* Free the memory allocated for the split line tokens */
-		for (i = 0; split_line[i] != NULL; ++i) {
-			free(split_line[i]);
-		}
-		free(split_line);
-	}
-	/* Close the file after processing */
-	fclose(file);
-	return FOUND;
+	result = expand_source(fileManager, macroManager, &source);
+	/* Release the source after processing */
+	close_source_manager(&source);
+	return result;
 }
 
 /**
@@ -159,8 +227,7 @@ void print_post_macro(FileManager* manager) {
 	/* depende on input file*/
 	max_columns = 0;
 	for (i = 0; i < manager->row_count; ++i) {
-		j = 0;
-		while (manager->post_macro[i][j] != NULL) j++;
+		j = get_post_macro_line_length(manager, i);
 		if (j > max_columns) {
 			max_columns = j;
 		}
@@ -174,16 +241,15 @@ void print_post_macro(FileManager* manager) {
 	printf("\n");
 
 	for (i = 0; i < manager->row_count; ++i) {
+		char** line = get_post_macro_line(manager, i);
 		printf("|");
-		for (j = 0; manager->post_macro[i][j] != NULL; ++j) {
-			printf(" %-10s |", manager->post_macro[i][j]); /* Adjust the width of columns as needed*/
+		for (j = 0; line[j] != NULL; ++j) {
+			printf(" %-10s |", line[j]); /* Adjust the width of columns as needed*/
 		}
 
 		/* Fill the remaining columns with empty spaces if the current row has fewer columns*/
-		for (j = 0; j < max_columns; ++j) {
-			if (manager->post_macro[i][j] == NULL) {
-				printf(" %-10s |", "");
-			}
+		for (; j < max_columns; ++j) {
+			printf(" %-10s |", "");
 		}
 		printf("\n");
 
@@ -197,90 +263,458 @@ void print_post_macro(FileManager* manager) {
 }
 
 /**
- * printPostMacroToFile -
- * Writes the content of the `post_macro` table from a FileManager structure
- * to a specified file. The data is formatted into a table, with columns
- * adjusted to fit the content.
- * @param file_name The base name of the file where the data will be written
- * @param fileManager A pointer to a FileManager structure containing the data to be printed
- * @return int 0 if the content was written successfully in the macro file otherwise 1
+ * print_post_macro_separator -
+ * Writes the line that separates the rows of the post-macro table.
+ *
+ * @param file The file to write to.
+ * @param max_columns The number of columns in the table.
  */
-int printPostMacroToFile(char* file_name, const FileManager* fileManager) {
-	int len;
-	int i, j, col, max_columns;
-	char* new_file_path;
-	FILE* file;
-	/*Concatenate extension string to the name of the file*/
-	len = strlen(file_name) + strlen(POST_MACRO_FILE_EXTENSION) + 1;
-	new_file_path = malloc(len);
+static void print_post_macro_separator(FILE* file, int max_columns) {
+	int col;
+	fprintf(file, "+");
+	for (col = 0; col < max_columns; ++col) {
+		fprintf(file, "------------+"); /* Adjust the width of columns as needed*/
+	}
+	fprintf(file, "\n");
+}
 
-	/*Failed to allocate memory*/
-	if (new_file_path == NULL) {
-		log_error("printPostMacroToFile", 219, "file_manager.c", "Memory allocation failed");
-		return NOT_FOUND;
+/**
+ * print_post_macro_row -
+ * Writes one row of the post-macro table followed by its separator.
+ *
+ * @param file The file to write to.
+ * @param line A NULL-terminated array of the row's tokens.
+ * @param max_columns The number of columns in the table.
+ */
+static void print_post_macro_row(FILE* file, char** line, int max_columns) {
+	int j;
+	fprintf(file, "|");
+	for (j = 0; line[j] != NULL; ++j) {
+		fprintf(file, " %-10s |", line[j]); /* Adjust the width of columns as needed*/
 	}
 
-	strcpy(new_file_path, file_name);
-	strcat(new_file_path, POST_MACRO_FILE_EXTENSION);
+	/* Fill the remaining columns with empty spaces if the current row has fewer columns*/
+	for (; j < max_columns; ++j) {
+		fprintf(file, " %-10s |", "");
+	}
+	fprintf(file, "\n");
+
+	/* Print the row separator*/
+	print_post_macro_separator(file, max_columns);
+}
 
-	/*Open file to write*/
-	file = fopen(new_file_path, "w");
+/**
+ * post_macro_separator -
+ * Gives what separates a token of a post-macro row from the next one. The tokenizer drops the commas,
+ * so they are put back between the arguments and a plain line assembles like the source line did.
+ *
+ * @param line A NULL-terminated array of the row's tokens.
+ * @param index The index of the token.
+ * @return ", " after an argument of an action or a directive, " " otherwise.
+ */
+static const char* post_macro_separator(char** line, int index) {
+	size_t length = strlen(line[0]);
+	/* The arguments follow the action or directive, which follows the label if there is one*/
+	int first_argument = length > 0 && line[0][length - 1] == ':' ? 2 : 1;
 
-	/*failed to open file*/
-	if (file == NULL) {
-		strcpy(new_file_path, file_name);
-		file_error("printPostMacroToFile", 232, "file_manager.c", "Failed to open file", new_file_path);
+	if (strcmp(line[0], ";") == 0 || index < first_argument) {
+		return " ";
+	}
+	return ", ";
+}
+
+/**
+ * print_post_macro_plain_row -
+ * Writes one row of the post-macro file as a plain line.
+ *
+ * @param file The file to write to.
+ * @param line A NULL-terminated array of the row's tokens.
+ */
+static void print_post_macro_plain_row(FILE* file, char** line) {
+	int j;
+	for (j = 0; line[j] != NULL; ++j) {
+		if (j > 0) {
+			fputs(post_macro_separator(line, j - 1), file);
+		}
+		fwrite(line[j], 1, strlen(line[j]), file);
+	}
+	fputc('\n', file);
+}
+
+/**
+ * printPostMacroPlain -
+ * Writes the post-macro table as plain lines, formatted into one buffer and written at once.
+ *
+ * @param file_name The base name of the file where the data will be written
+ * @param fileManager A pointer to a FileManager structure containing the data to be printed
+ * @return FOUND if the file was written, NOT_FOUND otherwise
+ */
+static int printPostMacroPlain(char* file_name, const FileManager* fileManager) {
+	size_t size = 0, used = 0, length;
+	int i, j, result;
+	char** line;
+	const char* separator;
+	char* buffer;
+
+	/* Every token takes its characters and a separator of up to 2 characters or the newline*/
+	for (i = 0; i < fileManager->row_count; ++i) {
+		line = get_post_macro_line(fileManager, i);
+		for (j = 0; line[j] != NULL; ++j) {
+			size += strlen(line[j]) + 2;
+		}
+		size++;
+	}
+
+	buffer = (char*)allocate_memory(fileManager->allocator, size + 1);
+	if (buffer == NULL) {
+		log_error("printPostMacroPlain", 342, "file_manager.c", "Memory allocation failed");
 		return NOT_FOUND;
 	}
+	for (i = 0; i < fileManager->row_count; ++i) {
+		line = get_post_macro_line(fileManager, i);
+		for (j = 0; line[j] != NULL; ++j) {
+			if (j > 0) {
+				separator = post_macro_separator(line, j - 1);
+				length = strlen(separator);
+				memcpy(buffer + used, separator, length);
+				used += length;
+			}
+			length = strlen(line[j]);
+			memcpy(buffer + used, line[j], length);
+			used += length;
+		}
+		buffer[used++] = '\n';
+	}
+	result = write_output_file(file_name, POST_MACRO_FILE_EXTENSION, buffer, used);
+	release_memory(fileManager->allocator, buffer);
+	return result;
+}
 
-	/*file opened start writing*/
-	fprintf(file, "post_macro\n");
-	/*Nothing to write*/
-	if (fileManager->row_count == 0) {
-		fprintf(file, "No data to display.\n");
-		return FOUND;
+/**
+ * format_post_macro_separator -
+ * Formats the line that separates the rows of the post-macro table.
+ *
+ * @param buffer Where the line is formatted.
+ * @param max_columns The number of columns in the table.
+ * @return The number of characters formatted.
+ */
+static size_t format_post_macro_separator(char* buffer, int max_columns) {
+	size_t used = 0;
+	int col;
+	buffer[used++] = '+';
+	for (col = 0; col < max_columns; ++col) {
+		memcpy(buffer + used, "------------+", POST_MACRO_CELL_WIDTH); /* Adjust the width of columns as needed*/
+		used += POST_MACRO_CELL_WIDTH;
 	}
-	/*There is data to write*/
+	buffer[used++] = '\n';
+	return used;
+}
+
+/**
+ * printPostMacroTable -
+ * Writes the post-macro table, formatted into one buffer and written at once.
+ *
+ * @param file_name The base name of the file where the data will be written
+ * @param fileManager A pointer to a FileManager structure containing the data to be printed
+ * @return FOUND if the file was written, NOT_FOUND otherwise
+ */
+static int printPostMacroTable(char* file_name, const FileManager* fileManager) {
+	size_t size, used = 0, length, separator_length;
+	int i, j, max_columns = 0, result;
+	char** line;
+	char* buffer;
+
 	/* Determine the maximum number of columns for proper formatting*/
-	/* depende on input file*/
-	max_columns = 0;
 	for (i = 0; i < fileManager->row_count; ++i) {
-		j = 0;
-		while (fileManager->post_macro[i][j] != NULL) j++;
+		j = get_post_macro_line_length(fileManager, i);
 		if (j > max_columns) {
 			max_columns = j;
 		}
 	}
 
-	/* Print the table*/
-	fprintf(file, "+");
-	for (col = 0; col < max_columns; ++col) {
-		fprintf(file, "------------+"); /* Adjust the width of columns as needed*/
-	}
-	fprintf(file, "\n");
-
+	/* Every row takes its cells, at least as wide as an empty one, its newline and a separator*/
+	separator_length = POST_MACRO_CELL_WIDTH * (size_t)max_columns + 2;
+	size = strlen(POST_MACRO_TABLE_TITLE) + strlen(POST_MACRO_TABLE_EMPTY) + separator_length;
 	for (i = 0; i < fileManager->row_count; ++i) {
-		fprintf(file, "|");
-		for (j = 0; fileManager->post_macro[i][j] != NULL; ++j) {
-			fprintf(file, " %-10s |", fileManager->post_macro[i][j]); /* Adjust the width of columns as needed*/
+		line = get_post_macro_line(fileManager, i);
+		size += 2 + POST_MACRO_CELL_WIDTH * (size_t)max_columns + separator_length;
+		for (j = 0; line[j] != NULL; ++j) {
+			length = strlen(line[j]);
+			if (length > POST_MACRO_CELL_WIDTH - 3) {
+				size += length - (POST_MACRO_CELL_WIDTH - 3);
+			}
 		}
+	}
 
-		/* Fill the remaining columns with empty spaces if the current row has fewer columns*/
-		for (j = 0; j < max_columns; ++j) {
-			if (fileManager->post_macro[i][j] == NULL) {
-				fprintf(file, " %-10s |", "");
+	buffer = (char*)allocate_memory(fileManager->allocator, size + 1);
+	if (buffer == NULL) {
+		log_error("printPostMacroTable", 451, "file_manager.c", "Memory allocation failed");
+		return NOT_FOUND;
+	}
+	length = strlen(POST_MACRO_TABLE_TITLE);
+	memcpy(buffer, POST_MACRO_TABLE_TITLE, length);
+	used = length;
+	if (fileManager->row_count == 0) {
+		/*Nothing to write*/
+		length = strlen(POST_MACRO_TABLE_EMPTY);
+		memcpy(buffer + used, POST_MACRO_TABLE_EMPTY, length);
+		used += length;
+	}
+	else {
+		/* Print the table*/
+		used += format_post_macro_separator(buffer + used, max_columns);
+		for (i = 0; i < fileManager->row_count; ++i) {
+			line = get_post_macro_line(fileManager, i);
+			buffer[used++] = '|';
+			for (j = 0; line[j] != NULL; ++j) {
+				used += sprintf(buffer + used, " %-10s |", line[j]); /* Adjust the width of columns as needed*/
 			}
+			/* Fill the remaining columns with empty spaces if the current row has fewer columns*/
+			for (; j < max_columns; ++j) {
+				used += sprintf(buffer + used, " %-10s |", "");
+			}
+			buffer[used++] = '\n';
+			used += format_post_macro_separator(buffer + used, max_columns);
 		}
-		fprintf(file, "\n");
+	}
+	result = write_output_file(file_name, POST_MACRO_FILE_EXTENSION, buffer, used);
+	release_memory(fileManager->allocator, buffer);
+	return result;
+}
 
-		/* Print the row separator*/
-		fprintf(file, "+");
-		for (col = 0; col < max_columns; ++col) {
-			fprintf(file, "------------+"); /* Adjust the width of columns as needed*/
+/**
+ * printPostMacroToFile -
+ * Writes the content of the `post_macro` table from a FileManager structure
+ * to a specified file. The data is formatted into a table, with columns
+ * adjusted to fit the content, or into plain lines, or not written at all.
+ * @param file_name The base name of the file where the data will be written
+ * @param fileManager A pointer to a FileManager structure containing the data to be printed
+ * @param format How the file is written.
+ * @return int 0 if the content was written successfully in the macro file otherwise 1
+ */
+int printPostMacroToFile(char* file_name, const FileManager* fileManager, PostMacroFormat format) {
+	if (format == PostMacroNone) {
+		return FOUND;
+	}
+	if (format == PostMacroPlain) {
+		return printPostMacroPlain(file_name, fileManager);
+	}
+	return printPostMacroTable(file_name, fileManager);
+}
+
+
+/**
+ * copy_source_line -
+ * Copies the tokens of the line the source has just read into a line buffer.
+ *
+ * @param source Pointer to the SourceManager holding the spans of the line.
+ * @param buffer Pointer to the LineBuffer to fill, it grows when the line does not fit.
+ * @return FOUND if the line was copied, NOT_FOUND if memory allocation failed.
+ */
+static int copy_source_line(const SourceManager* source, LineBuffer* buffer) {
+	int i;
+	long used = 0;
+
+	/* Every token takes its characters and a null terminator*/
+	for (i = 0; i < source->span_count; i++) {
+		used += source->spans[i].length + 1;
+	}
+	if (used > buffer->char_size) {
+		char* new_chars = (char*)realloc(buffer->chars, used);
+		if (new_chars == NULL) {
+			log_error("copy_source_line", 391, "file_manager.c", "Memory allocation failed");
+			return NOT_FOUND;
+		}
+		buffer->chars = new_chars;
+		buffer->char_size = used;
+	}
+	if (source->span_count + 1 > buffer->token_size) {
+		char** new_tokens = (char**)realloc(buffer->tokens, (source->span_count + 1) * sizeof(char*));
+		if (new_tokens == NULL) {
+			log_error("copy_source_line", 400, "file_manager.c", "Memory allocation failed");
+			return NOT_FOUND;
+		}
+		buffer->tokens = new_tokens;
+		buffer->token_size = source->span_count + 1;
+	}
+
+	used = 0;
+	for (i = 0; i < source->span_count; i++) {
+		char* token = buffer->chars + used;
+		memcpy(token, source->data + source->spans[i].offset, source->spans[i].length);
+		token[source->spans[i].length] = '\0';
+		used += source->spans[i].length + 1;
+		buffer->tokens[i] = token;
+	}
+	buffer->tokens[source->span_count] = NULL;
+	return FOUND;
+}
+
+/**
+ * stream_macro_pass -
+ * Expands the macros of the whole source one line at a time.
+ * A macro keeps the offsets of its lines in the source, an expansion reads them again from there.
+ * Without a file, the pass only measures the post-macro table.
+ *
+ * @param source Pointer to the SourceManager of the input, positioned at its start.
+ * @param macroManager Pointer to an empty MacroManager.
+ * @param buffer Pointer to the LineBuffer used for the tokens of each line.
+ * @param file The file the rows are written to, or NULL to only measure them.
+ * @param format How the rows are written.
+ * @param max_columns Updated with the number of tokens of the longest row.
+ * @param row_count Updated with the number of rows.
+ * @return FOUND if the whole source was processed, NOT_FOUND if memory allocation failed.
+ */
+static int stream_macro_pass(SourceManager* source, MacroManager* macroManager, LineBuffer* buffer, FILE* file, PostMacroFormat format, int* max_columns, long* row_count) {
+	int i;
+	long line_position = source->position;
+
+	while (next_source_line(source)) {
+		const Macro* macro;
+		if (!copy_source_line(source, buffer)) {
+			return NOT_FOUND;
+		}
+
+		/* Check if the first token is a macro name */
+		macro = source->span_count > 0 ? find_macro(macroManager, buffer->tokens[0]) : NULL;
+		if (macro != NULL) {
+			*row_count += macro->row_count;
+			if (macro->width > *max_columns) {
+				*max_columns = macro->width;
+			}
+			if (file != NULL) {
+				/* Read the macro's lines again from the source, then continue after the invocation */
+				long next_position = source->position;
+				for (i = 0; i < macro->row_count; i++) {
+					source->position = macro->lines[i];
+					if (!next_source_line(source) || !copy_source_line(source, buffer)) {
+						return NOT_FOUND;
+					}
+					if (format == PostMacroPlain) {
+						print_post_macro_plain_row(file, buffer->tokens);
+					}
+					else {
+						print_post_macro_row(file, buffer->tokens, *max_columns);
+					}
+				}
+				source->position = next_position;
+			}
 		}
-		fprintf(file, "\n");
+		else if (process_file_line(macroManager, buffer->tokens, source->span_count, line_position) == ProgramLine) {
+			/* The line is part of the program */
+			(*row_count)++;
+			if (source->span_count > *max_columns) {
+				*max_columns = source->span_count;
+			}
+			if (file != NULL && format == PostMacroPlain) {
+				print_post_macro_plain_row(file, buffer->tokens);
+			}
+			else if (file != NULL) {
+				print_post_macro_row(file, buffer->tokens, *max_columns);
+			}
+		}
+		line_position = source->position;
 	}
 	return FOUND;
 }
 
+/**
+ * stream_post_macro -
+ * Expands the macros of an input file and writes the post-macro file without keeping the
+ * program in memory. Only the macros' line offsets are kept, so memory does not grow with the
+ * size of the file. The source is read twice for a table: first to find the width of the table,
+ * then to write it. Plain lines are written in one pass, and with no post-macro file the
+ * macros are only expanded.
+ *
+ * @param file_name The base name of the input file, without its extension.
+ * @param format How the post-macro file is written.
+ * @return FOUND if the post-macro file was written, NOT_FOUND otherwise.
+ */
+int stream_post_macro(char* file_name, PostMacroFormat format) {
+	int len, result, max_columns = 0;
+	long row_count = 0;
+	char* new_file_path;
+	FILE* file;
+	Arena arena;
+	Allocator allocator;
+	MacroManager macroManager;
+	SourceManager source;
+	LineBuffer buffer;
+
+	/*Concatenate extension string to the name of the file*/
+	len = strlen(file_name) + strlen(POST_MACRO_FILE_EXTENSION) + strlen(INPUT_FILE_EXTENSION) + 1;
+	new_file_path = malloc(len);
+	if (new_file_path == NULL) {
+		log_error("stream_post_macro", 502, "file_manager.c", "Memory allocation failed");
+		return NOT_FOUND;
+	}
+	strcpy(new_file_path, file_name);
+	strcat(new_file_path, INPUT_FILE_EXTENSION);
+
+	/* Map the specified file for reading*/
+	if (!open_source_manager(&source, new_file_path)) {
+		file_error("stream_post_macro", 510, "file_manager.c", "Failed to open file", new_file_path);
+		free(new_file_path);
+		return NOT_FOUND;
+	}
+
+	buffer.chars = NULL;
+	buffer.char_size = 0;
+	buffer.tokens = NULL;
+	buffer.token_size = 0;
+
+	/* Only the macros are kept, each pass takes them from the allocator and releases them*/
+	init_arena(&arena);
+	init_allocator(&allocator, DEFAULT_ALLOCATOR, &arena);
+
+	/* The first pass only measures the table*/
+	result = FOUND;
+	if (format != PostMacroPlain) {
+		init_macro_manager(&macroManager, &allocator);
+		result = stream_macro_pass(&source, &macroManager, &buffer, NULL, format, &max_columns, &row_count);
+		release_allocator(&allocator);
+	}
+
+	file = NULL;
+	if (result && format != PostMacroNone) {
+		/*Open file to write*/
+		strcpy(new_file_path, file_name);
+		strcat(new_file_path, POST_MACRO_FILE_EXTENSION);
+		file = fopen(new_file_path, "w");
+		if (file == NULL) {
+			file_error("stream_post_macro", 533, "file_manager.c", "Failed to open file", new_file_path);
+			result = NOT_FOUND;
+		}
+	}
+	free(new_file_path);
+
+	if (file != NULL && format == PostMacroPlain) {
+		/* The rows are written as they are expanded*/
+		init_macro_manager(&macroManager, &allocator);
+		result = stream_macro_pass(&source, &macroManager, &buffer, file, format, &max_columns, &row_count);
+		release_allocator(&allocator);
+		fclose(file);
+	}
+	else if (file != NULL) {
+		fputs(POST_MACRO_TABLE_TITLE, file);
+		if (row_count == 0) {
+			fputs(POST_MACRO_TABLE_EMPTY, file);
+		}
+		else {
+			/* The second pass writes the rows as they are expanded*/
+			source.position = 0;
+			row_count = 0;
+			init_macro_manager(&macroManager, &allocator);
+			print_post_macro_separator(file, max_columns);
+			result = stream_macro_pass(&source, &macroManager, &buffer, file, format, &max_columns, &row_count);
+			release_allocator(&allocator);
+		}
+		fclose(file);
+	}
+
+	free(buffer.chars);
+	free(buffer.tokens);
+	close_source_manager(&source);
+	return result;
+}
 
@@ -6,24 +6,69 @@
 #include <string.h>
 
 #include "strings_manager.h"
+#include "source_manager.h"
 #include "macro_manager.h"
+#include "memory_manager.h"
+#include "queue_manager.h"
+#include "output_manager.h"
 #include "constants.h"
 #include "error_manager.h"
 
 
-#define MAX_LINE_LENGTH 1024
 #define INPUT_DIR 
 
+#define LINES_INITIAL_SIZE 64
+#define POST_MACRO_CELL_WIDTH 13 /* A cell of the post-macro table is " %-10s |", a token of up to 10 characters*/
+#define POST_MACRO_TABLE_TITLE "post_macro\n"
+#define POST_MACRO_TABLE_EMPTY "No data to display.\n"
+
+/* The post-macro program is kept flat: every token of every line lives in one character pool,
+ * the lines' tokens follow each other in one array (each line ends with NULL),
+ * and lines holds the index in tokens where each line starts.
+ * A macro's lines are stored once, each expansion only adds their indexes to lines.
+ * The pool and the tokens array are sized from the source once and never move, so a line's
+ * tokens stay valid while later lines are added*/
 typedef struct {
-	char*** post_macro;
+	Allocator* allocator; /* Owner of the table's memory*/
+	char* pool;      /* Null-terminated characters of the tokens*/
+	long pool_used;
+	long pool_size;
+	char** tokens;   /* Tokens of all the lines, each line is terminated by NULL*/
+	int token_count;
+	int token_size;
+	int* lines;      /* Index in tokens of the first token of each line*/
 	int row_count;
+	int line_size;
+	LineQueue* queue; /* When set, every line added to the table is also handed to the first scan*/
+	long source_lines;     /* Lines read from the source*/
+	long source_tokens;    /* Tokens read from the source*/
+	long macro_expansions; /* Macro invocations that were expanded*/
 } FileManager;
 
-void initialize_file_manager(FileManager* manager);
-void free_file_manager(FileManager* manager);
+/* How the post-macro file is written*/
+typedef enum PostMacroFormat {
+	PostMacroTable,  /* A table with a cell for every token*/
+	PostMacroPlain,  /* One line per row, the tokens separated by a space*/
+	PostMacroNone    /* No post-macro file*/
+} PostMacroFormat;
+
+/* The tokens of one source line copied out of the source, so each one is null-terminated.
+ * Used when the file is streamed and no table is kept*/
+typedef struct {
+	char* chars;     /* Null-terminated characters of the tokens*/
+	long char_size;
+	char** tokens;   /* Tokens of the line, terminated by NULL*/
+	int token_size;
+} LineBuffer;
+
+void initialize_file_manager(FileManager* manager, Allocator* allocator);
+int expand_source(FileManager* fileManager, MacroManager* macroManager, SourceManager* source);
 int input_process(FileManager* fileManager, MacroManager* macroManager, char* file_path);
+char** get_post_macro_line(const FileManager* manager, int row);
+int get_post_macro_line_length(const FileManager* manager, int row);
 void print_post_macro(FileManager* manager);
-int printPostMacroToFile(char* file_name, const FileManager* fileManager);
+int printPostMacroToFile(char* file_name, const FileManager* fileManager, PostMacroFormat format);
+int stream_post_macro(char* file_name, PostMacroFormat format);
 
 #endif /* FILE_MANAGER_H*/
 
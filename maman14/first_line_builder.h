@@ -6,6 +6,7 @@
 #include <string.h>
 
 #include "symbols_manager.h"
+#include "line_builder.h"
 #include "actions.h"
 #include "strings_manager.h"
 #include "operands.h"
@@ -14,17 +15,14 @@
 #include "error_manager.h"
 
 
-#define ACTION_CODE_LENGTH 4
-#define OPERAND_CODE_LENGTH 4
-#define TOTAL_LENGTH (ACTION_CODE_LENGTH + 2 * OPERAND_CODE_LENGTH + 1) // Adjust based on your needs
-
-/* Function to generate operand code based on the provided operand string*/
-char* generate_operand_code(Registers* registers, const char* operand);
+#define ACTION_CODE_SHIFT 11    /* The action code is in bits 11-14*/
+#define SOURCE_CODE_SHIFT 7     /* The source operand's addressing is in bits 7-10*/
+#define TARGET_CODE_SHIFT 3     /* The target operand's addressing is in bits 3-6*/
 
 /* Function to generate the first line of output based on the given parameters*/
-char* generate_first_line(Action* actions, char* action_name, const char* operand_target, const char* operand_source, Registers* registers);
+int generate_first_line(Word* slot, const Action* action, const ParsedOperand* operand_target, const ParsedOperand* operand_source);
 
-char* process_first_line(Action* actions,  char** line,Registers* registers);
+int process_first_line(Word* slot, const ParsedLine* parsed);
 
 #endif /* FIRST_LINE_BUILDER_H*/
 
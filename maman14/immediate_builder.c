@@ -2,48 +2,32 @@
 
 /**
  * immediate_are - 
- * Returns a static string representation for Immediate addressing.
+ * Returns the ARE bits for Immediate addressing.
  *
- * @return A string representing the Addressing Mode for Immediate values.
+ * @return The ARE bits of an Immediate value.
  */
-char* immediate_are() {
-	return "100";
+Word immediate_are(void) {
+	return ARE_ABSOLUTE;
 }
 
 /**
  * generate_immediate_line -
- * Generates the binary code for an Immediate operand.
+ * Encodes an Immediate operand into the word slot given by the caller.
  *
+ * @param slot The word to write.
  * @param num The immediate value to be encoded.
- * @return A string representing the binary code for the immediate operand, or NULL if memory allocation fails or an error occurs.
+ * @return FOUND if the word was written, NOT_FOUND if the value doesn't fit in 12 bits.
  */
-char* generate_immediate_line(int num) {
-	char* combinedString;
-	int combinedLength;
-	/* Generate binary string representation*/
-	char* binaryString = intTo12Bit2ComplementString(num);
-	char* staticString = immediate_are(); /* Static string*/
-	
-	/* Check for NULL pointers and free allocated memory if necessary*/
-	if (!binaryString) {
-		return NULL; /* Return NULL if binaryString is NULL*/
-	}
+int generate_immediate_line(Word* slot, int num) {
+	/* Generate the 12-bit value*/
+	Word value = intTo12Bit2Complement(num);
 
-	/* Allocate memory for the combined result*/
-	combinedLength = strlen(binaryString) + strlen(staticString) + 1;
-	combinedString = (char*)malloc(combinedLength);
-	if (!combinedString) {
-		free(binaryString); /* Free the binary string if memory allocation failed*/
-		return NULL; /* Memory allocation failed*/
+	if (value == NO_WORD) {
+		return NOT_FOUND;
 	}
 
-	/* Combine the strings*/
-	strcpy(combinedString, binaryString);
-	strcat(combinedString, staticString);
-
-	/* Free the allocated memory for the binary string*/
-	free(binaryString);
-
-	return combinedString;
+	/* The value is followed by the ARE bits*/
+	*slot = (Word)(value << ARE_BITS | immediate_are());
+	return FOUND;
 }
 
@@ -14,8 +14,8 @@
 
 
 /* Function prototypes*/
-char* immediate_are(void);
-char* generate_immediate_line(int num);
+Word immediate_are(void);
+int generate_immediate_line(Word* slot, int num);
 
 #endif /* NUMBER_HANDLER_H*/
 
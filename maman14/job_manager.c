@@ -0,0 +1,143 @@
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "job_manager.h"
+
+/**
+ * run_job -
+ * Runs a job and records which worker ran it and when.
+ *
+ * @param job The job to run.
+ * @param thread The index of the worker.
+ * @param runner The function that runs the job.
+ * @param context Read-only data shared by all the jobs.
+ */
+static void run_job(Job* job, int thread, JobRunner runner, void* context) {
+	job->thread = thread;
+	job->start = stats_time();
+	runner(job, context);
+	job->seconds = stats_time() - job->start;
+}
+
+#ifdef USE_THREADS
+#include <pthread.h>
+
+/* The jobs shared by the threads of run_jobs*/
+typedef struct {
+	Job* jobs;
+	int job_count;
+	JobRunner runner;
+	void* context;
+	int next_job;    /* The next job to take*/
+	int next_print;  /* The first job whose errors were not printed yet*/
+	pthread_mutex_t lock;
+} JobPool;
+
+/* One thread of the pool*/
+typedef struct {
+	JobPool* pool;
+	int index;  /* 0 for the calling thread*/
+} JobWorker;
+
+/**
+ * run_pool_jobs -
+ * Thread entry that takes jobs until none is left.
+ * After each job, the errors of the jobs that are done are printed, up to the first job that is not.
+ *
+ * @param argument Pointer to the JobWorker of the thread.
+ * @return NULL.
+ */
+static void* run_pool_jobs(void* argument) {
+	JobWorker* worker = (JobWorker*)argument;
+	JobPool* pool = worker->pool;
+	Job* job;
+
+	while (1) {
+		pthread_mutex_lock(&pool->lock);
+		job = pool->next_job < pool->job_count ? &pool->jobs[pool->next_job++] : NULL;
+		pthread_mutex_unlock(&pool->lock);
+		if (job == NULL) {
+			return NULL;
+		}
+
+		set_error_log(&job->errors);
+		run_job(job, worker->index, pool->runner, pool->context);
+		set_error_log(NULL);
+
+		pthread_mutex_lock(&pool->lock);
+		job->is_done = FOUND;
+		while (pool->next_print < pool->job_count && pool->jobs[pool->next_print].is_done) {
+			print_error_log(&pool->jobs[pool->next_print].errors, stderr);
+			pool->next_print++;
+		}
+		pthread_mutex_unlock(&pool->lock);
+	}
+}
+#endif
+
+/**
+ * run_jobs -
+ * Runs every job, on thread_count threads when threads are available.
+ * The calling thread is one of them. The errors of each job are kept until the errors
+ * of the jobs before it were printed, so they come out in the order of the jobs.
+ *
+ * @param jobs The jobs, in the order of the command line.
+ * @param job_count The number of jobs.
+ * @param thread_count The number of threads to run the jobs on.
+ * @param runner The function that runs a job.
+ * @param context Read-only data shared by all the jobs.
+ */
+void run_jobs(Job* jobs, int job_count, int thread_count, JobRunner runner, void* context) {
+	int i;
+#ifdef USE_THREADS
+	JobPool pool;
+	JobWorker workers[MAX_JOB_THREADS];
+	pthread_t threads[MAX_JOB_THREADS];
+	int started = 0;
+#endif
+
+	for (i = 0; i < job_count; i++) {
+		init_error_log(&jobs[i].errors);
+		jobs[i].is_done = NOT_FOUND;
+	}
+
+#ifdef USE_THREADS
+	if (thread_count > job_count) {
+		thread_count = job_count;
+	}
+	if (thread_count > MAX_JOB_THREADS) {
+		thread_count = MAX_JOB_THREADS;
+	}
+	if (thread_count > 1) {
+		pool.jobs = jobs;
+		pool.job_count = job_count;
+		pool.runner = runner;
+		pool.context = context;
+		pool.next_job = 0;
+		pool.next_print = 0;
+		pthread_mutex_init(&pool.lock, NULL);
+
+		for (i = 0; i < thread_count; i++) {
+			workers[i].pool = &pool;
+			workers[i].index = i;
+		}
+		/* A thread that can't be started only means fewer threads*/
+		while (started < thread_count - 1 && pthread_create(&threads[started], NULL, run_pool_jobs, &workers[started + 1]) == 0) {
+			started++;
+		}
+		run_pool_jobs(&workers[0]);
+		for (i = 0; i < started; i++) {
+			pthread_join(threads[i], NULL);
+		}
+		pthread_mutex_destroy(&pool.lock);
+		return;
+	}
+#endif
+
+	/* One file after the other, the errors are printed as they happen*/
+	for (i = 0; i < job_count; i++) {
+		run_job(&jobs[i], 0, runner, context);
+		jobs[i].is_done = FOUND;
+	}
+}
@@ -0,0 +1,33 @@
+#ifndef JOB_MANAGER_H
+#define JOB_MANAGER_H
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "constants.h"
+#include "error_manager.h"
+#include "file_manager.h"
+#include "stats_manager.h"
+
+#define MAX_JOB_THREADS 256
+
+/* One input file of the command line*/
+typedef struct {
+	char* file_name;      /* The base name of the input file, without its extension*/
+	int preprocess_only;  /* FOUND if only the macros are expanded (-E)*/
+	PostMacroFormat post_macro_format; /* How the .am file is written (--am)*/
+	AllocatorKind allocator; /* Where the memory of the file is taken from (--allocator)*/
+	ErrorLog errors;      /* The errors of the file, printed in the order of the command line*/
+	FileStats stats;      /* What assembling the file took (--stats)*/
+	int thread;           /* The worker that ran the job, 0 is the calling thread*/
+	double start;         /* stats_time when the job started*/
+	double seconds;       /* How long the job took*/
+	int is_done;
+} Job;
+
+/* Processes one file, everything it uses is its own except the read-only context*/
+typedef void (*JobRunner)(Job* job, void* context);
+
+void run_jobs(Job* jobs, int job_count, int thread_count, JobRunner runner, void* context);
+
+#endif /* JOB_MANAGER_H*/
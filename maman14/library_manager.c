@@ -0,0 +1,85 @@
+#include "library_manager.h"
+
+/**
+ * assemble_source -
+ * Assembles a source held in memory, without reading or writing any file.
+ * Everything the source uses is its own, so sources can be assembled at the same time on different threads.
+ * The errors are kept in the result instead of being printed.
+ *
+ * @param text The characters of the source, as they would be in a .as file.
+ * @param length The number of characters in text.
+ * @param result Pointer to the Assembly that receives the words, the references and the errors.
+ *               It must be released with release_assembly, whatever is returned.
+ * @return FOUND if the source was assembled without errors, NOT_FOUND otherwise.
+ */
+int assemble_source(const char* text, long length, Assembly* result) {
+	FileManager fileManager;
+	MacroManager macroManager;
+	AssemblerManager* assemblerManager;
+	SymbolsManager* symbolsManager;
+	SourceManager source;
+	Registers registers[NUM_OF_REGISTERS];
+	Registers_2 registers_2[NUM_OF_REGISTERS];
+	ErrorLog* caller_errors = get_error_log();
+
+	init_arena(&result->arena);
+	init_arena(&result->scan_arena);
+	init_allocator(&result->allocator, BumpAllocator, &result->arena);
+	init_allocator(&result->scan_allocator, BumpAllocator, &result->scan_arena);
+	init_error_log(&result->errors);
+	result->has_errors = FOUND;
+	result->code_count = 0;
+	result->data_count = 0;
+	result->code = NULL;
+	result->data = NULL;
+	result->references = NULL;
+	result->reference_count = 0;
+
+	/* The errors of this source go to the result until it is assembled*/
+	set_error_log(&result->errors);
+
+	initialize_operands(registers, registers_2);
+	initialize_file_manager(&fileManager, &result->allocator);
+	init_macro_manager(&macroManager, &result->allocator);
+	assemblerManager = createAssemblerManager(&result->scan_allocator);
+	symbolsManager = createSymbolsManager(&result->scan_allocator);
+
+	if (assemblerManager != NULL && symbolsManager != NULL && open_source_buffer(&source, text, length)) {
+		if (run_first_pass_source(&fileManager, &macroManager, &source, assemblerManager, symbolsManager, registers, registers_2, NULL)) {
+			updateLocationDataSymbols(symbolsManager, assemblerManager);
+			updateDataItemsLocation(assemblerManager);
+			second_scan(assemblerManager, symbolsManager);
+
+			result->has_errors = assemblerManager->has_assembler_errors == NOT_FOUND && symbolsManager->has_symbols_errors == NOT_FOUND ? NOT_FOUND : FOUND;
+			result->code_count = assemblerManager->actionItemCount;
+			result->data_count = assemblerManager->dataItemCount;
+			result->code = assemblerManager->actionItems;
+			result->data = assemblerManager->dataItems;
+			result->references = symbolsManager->ref_symbols;
+			result->reference_count = symbolsManager->ref_used;
+		}
+		close_source_manager(&source);
+	}
+
+	set_error_log(caller_errors);
+	return result->has_errors ? NOT_FOUND : FOUND;
+}
+
+/**
+ * release_assembly -
+ * Releases everything an Assembly holds.
+ *
+ * @param result Pointer to the Assembly to release.
+ */
+void release_assembly(Assembly* result) {
+	release_arena(&result->scan_arena);
+	release_arena(&result->arena);
+	free(result->errors.text);
+	init_error_log(&result->errors);
+	result->code = NULL;
+	result->data = NULL;
+	result->references = NULL;
+	result->code_count = 0;
+	result->data_count = 0;
+	result->reference_count = 0;
+}
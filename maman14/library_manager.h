@@ -0,0 +1,38 @@
+#ifndef LIBRARY_MANAGER_H
+#define LIBRARY_MANAGER_H
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "constants.h"
+#include "error_manager.h"
+#include "memory_manager.h"
+#include "source_manager.h"
+#include "file_manager.h"
+#include "macro_manager.h"
+#include "assembler_manager.h"
+#include "symbols_manager.h"
+#include "pipeline_manager.h"
+#include "operands.h"
+
+/* Everything the assembler made of one source, in memory instead of the .ob, .ent and .ext files.
+ * The result owns its memory, it is valid until release_assembly*/
+typedef struct {
+	Arena arena;       /* Memory of the macro stage, the items' metadata points into it*/
+	Arena scan_arena;  /* Memory of the scans, owner of the items and the references*/
+	Allocator allocator;      /* Bump allocators over the two arenas, the managers take their memory from them*/
+	Allocator scan_allocator;
+	int has_errors;    /* FOUND if the source has errors, the items and references are then incomplete*/
+	int code_count;    /* The number of words of the instructions, IC in the .ob file*/
+	int data_count;    /* The number of words of the data, DC in the .ob file*/
+	const Item* code;  /* The instructions' words, in the order of the .ob file*/
+	const Item* data;  /* The data words, after the instructions*/
+	const ReferenceSymbol* references; /* The .ext (type FOUND) and .ent (type NOT_FOUND) lines*/
+	int reference_count;
+	ErrorLog errors;   /* The error messages, errors.text is null-terminated when it is not NULL*/
+} Assembly;
+
+int assemble_source(const char* text, long length, Assembly* result);
+void release_assembly(Assembly* result);
+
+#endif /* LIBRARY_MANAGER_H*/
@@ -0,0 +1,109 @@
+#include "line_builder.h"
+#include "symbols_manager.h"
+#include "register_builder.h"
+
+/**
+ * build_operand -
+ * Classifies an operand of an action.
+ *
+ * @param operand The operand to fill.
+ * @param text The operand as written.
+ * @param symbolsManager The SymbolsManager the label of a Direct operand is interned in.
+ * @return FOUND if the operand was classified, NOT_FOUND if its label couldn't be interned.
+ */
+static int build_operand(ParsedOperand* operand, const char* text, struct SymbolsManager* symbolsManager, Registers* registers, Registers_2* registers_2) {
+	operand->text = text;
+	operand->symbol = NO_ATOM;
+	operand->addressing = get_addressing_type(registers, registers_2, text);
+	operand->register_number = NO_REGISTER;
+	operand->value = 0;
+	switch (operand->addressing) {
+	case Immediate:
+		operand->mode = ADDRESSING_IMMEDIATE;
+		operand->value = atoi(text + 1);
+		break;
+	case DirectRegister:
+		operand->mode = ADDRESSING_DIRECT_REGISTER;
+		operand->register_number = text[1] - '0';
+		break;
+	case IndirectRegister:
+		operand->mode = ADDRESSING_INDIRECT_REGISTER;
+		operand->register_number = text[2] - '0'; /* the reg number without * sign*/
+		break;
+	default:
+		/* The label is resolved by its atom in the second scan*/
+		operand->mode = ADDRESSING_DIRECT;
+		operand->symbol = internSymbolName(symbolsManager, text, strlen(text));
+		if (operand->symbol == NO_ATOM) {
+			log_error("build_operand", 38, "line_builder.c", "Failed to intern symbol_name");
+			return NOT_FOUND;
+		}
+		break;
+	}
+	return FOUND;
+}
+
+/**
+ * build_line -
+ * Classifies a line of the post-macro program once, so the scans don't compare its tokens again.
+ *
+ * @param parsed The line to fill.
+ * @param line A NULL-terminated array of the line's tokens.
+ * @param symbolsManager The SymbolsManager the label is interned in.
+ * @return FOUND if the line was classified, NOT_FOUND if a label couldn't be interned.
+ */
+int build_line(ParsedLine* parsed, char** line, struct SymbolsManager* symbolsManager, Registers* registers, Registers_2* registers_2) {
+	int i;
+
+	parsed->label = NO_ATOM;
+	parsed->words = line;
+	parsed->arguments = line + 1;
+	parsed->action = NULL;
+	parsed->operand_count = 0;
+
+	/*If the line starts with ; it's a comment*/
+	if (strcmp(line[0], ";") == 0 || strcmp(line[0], "file") == 0) {
+		parsed->type = CommentLine;
+		return FOUND;
+	}
+	if (isReferencePattern(line[0])) {
+		parsed->type = line[0][2] == 'x' ? ExternLine : EntryLine;
+		return FOUND;
+	}
+
+	/* The symbol's name is the label without its ':'*/
+	if (isSymbolPattern(line[0])) {
+		parsed->label = internSymbolName(symbolsManager, line[0], strlen(line[0]) - 1);
+		if (parsed->label == NO_ATOM) {
+			log_error("build_line", 68, "line_builder.c", "Failed to intern symbol_name");
+			return NOT_FOUND;
+		}
+		parsed->words = line + 1;
+		parsed->arguments = line + 2;
+		if (line[1] == NULL) {
+			parsed->type = UnknownLine;
+			return FOUND;
+		}
+	}
+
+	if (isDataPattern(parsed->words[0])) {
+		parsed->type = parsed->words[0][1] == 'd' ? DataLine : StringLine;
+		return FOUND;
+	}
+	parsed->action = find_action(parsed->words[0]);
+	if (parsed->action == NULL) {
+		parsed->type = UnknownLine;
+		return FOUND;
+	}
+
+	parsed->type = ActionLine;
+	while (parsed->arguments[parsed->operand_count] != NULL) {
+		parsed->operand_count++;
+	}
+	for (i = 0; i < parsed->operand_count && i < MAX_LINE_OPERANDS; i++) {
+		if (!build_operand(&parsed->operands[i], parsed->arguments[i], symbolsManager, registers, registers_2)) {
+			return NOT_FOUND;
+		}
+	}
+	return FOUND;
+}
@@ -0,0 +1,52 @@
+#ifndef LINE_BUILDER_H
+#define LINE_BUILDER_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "actions.h"
+#include "operands.h"
+#include "atom_manager.h"
+#include "constants.h"
+#include "error_manager.h"
+
+#define MAX_LINE_OPERANDS 2 /* The operands of an action that are encoded*/
+
+struct SymbolsManager;
+
+/* What a line of the post-macro program is*/
+typedef enum LineType {
+	CommentLine,  /* A comment, nothing to do*/
+	ExternLine,   /* .extern*/
+	EntryLine,    /* .entry*/
+	DataLine,     /* .data*/
+	StringLine,   /* .string*/
+	ActionLine,   /* An action and its operands*/
+	UnknownLine   /* Neither of the above*/
+} LineType;
+
+/* An operand of an action, as the encoders need it*/
+typedef struct {
+	const char* text;           /* The operand as written*/
+	AddressingType addressing;
+	int mode;                   /* The ADDRESSING_* bit of the addressing type*/
+	int register_number;        /* The register of a register operand, NO_REGISTER otherwise*/
+	int value;                  /* The value of an Immediate operand*/
+	Atom symbol;                /* The atom of a Direct operand's label in the SymbolsManager, NO_ATOM otherwise*/
+} ParsedOperand;
+
+/* A line of the post-macro program, classified once and read by the scans instead of its tokens*/
+typedef struct {
+	LineType type;
+	Atom label;                 /* The atom of the line's label in the SymbolsManager, NO_ATOM if there is none*/
+	char** words;               /* The tokens after the label*/
+	char** arguments;           /* The tokens after the action or directive*/
+	const Action* action;       /* The action of an ActionLine*/
+	int operand_count;          /* The number of arguments of an ActionLine*/
+	ParsedOperand operands[MAX_LINE_OPERANDS]; /* The first arguments of an ActionLine, in the order they are written*/
+} ParsedLine;
+
+int build_line(ParsedLine* parsed, char** line, struct SymbolsManager* symbolsManager, Registers* registers, Registers_2* registers_2);
+
+#endif /*LINE_BUILDER_H*/
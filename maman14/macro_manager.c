@@ -1,3 +1,4 @@
+
 #include "macro_manager.h"
 
 /**
@@ -5,140 +6,135 @@
  * Initializes the MacroManager structure.
  *
  * @param manager A pointer to the MacroManager structure to be initialized.
+ * @param allocator The allocator that owns the macros' memory.
  */
-void init_macro_manager(MacroManager* manager) {
+void init_macro_manager(MacroManager* manager, Allocator* allocator) {
+	manager->allocator = allocator;
+	init_atom_table(&manager->names, allocator);
+	manager->macros = NULL;
 	manager->macro_count = 0;
+	manager->macro_size = 0;
 	manager->is_macro_context = 0;
+	manager->current_macro = 0;
+}
+
+/**
+ * find_macro_index -
+ * Looks a macro name up.
+ *
+ * @param manager A pointer to the MacroManager structure that contains the macros.
+ * @param name The name to look for.
+ * @return The index of the macro in manager->macros, or -1 if there is no macro with this name.
+ */
+static int find_macro_index(const MacroManager* manager, const char* name) {
+	/* Only macro names are interned, so the atom of a name is the index of its macro*/
+	return find_atom(&manager->names, name, strlen(name));
 }
 
+/**
+ * add_macro -
+ * Adds a new macro without lines.
+ *
+ * @param manager A pointer to the MacroManager structure.
+ * @param name The name of the macro.
+ * @return The index of the new macro, or -1 if memory allocation failed.
+ */
+static int add_macro(MacroManager* manager, const char* name) {
+	Atom atom;
+	Macro* macro;
+
+	if (manager->macro_count == manager->macro_size) {
+		int new_size = manager->macro_size ? manager->macro_size * 2 : MACROS_INITIAL_SIZE;
+		Macro* new_macros = (Macro*)resize_memory(manager->allocator, manager->macros, new_size * sizeof(Macro));
+		if (new_macros == NULL) {
+			log_error("add_macro", 50, "macro_manager.c", "Memory allocation failed");
+			return -1;
+		}
+		manager->macros = new_macros;
+		manager->macro_size = new_size;
+	}
+
+	atom = intern_atom(&manager->names, name, strlen(name));
+	if (atom == NO_ATOM) {
+		return -1;
+	}
+
+	macro = &manager->macros[atom];
+	macro->name = atom_name(&manager->names, atom);
+	macro->lines = NULL;
+	macro->row_count = 0;
+	macro->row_size = 0;
+	macro->width = 0;
+	return manager->macro_count++;
+}
 
 /**
  *process_file_line -
- * Processes a line of input, checking for macro definitions and expansions.
+ * Processes a line of input, checking for macro definitions.
+ * The lines of a macro are not copied, the macro keeps the position the caller gives for them.
  *
  * @param manager A pointer to the MacroManager structure used to manage macro definitions and expansions.
  * @param input A pointer to an array of strings (char**) representing the tokens of the input line.
  * @param input_count The number of tokens in the input line.
+ * @param line_position The position of the line, used by the caller to find the line again.
  *
- * @return A processed line as an array of strings (char**). If the line defines or is part of a macro, the function returns NULL.
+ * @return ProgramLine if the line is part of the program, MacroLine if the line is now
+ *         referenced by a macro and must be kept, SkippedLine if the line can be dropped.
  */
-char** process_file_line(MacroManager* manager, char** input, int input_count) {
-	int i, j;
-	char** processed_line;
-
-	/* If the input line is empty, return NULL */
-	if (input_count == 0) return NULL;
+LineKind process_file_line(MacroManager* manager, char** input, int input_count, long line_position) {
+	/* If the input line is empty, it is not part of the program */
+	if (input_count == 0) return SkippedLine;
 
-	/* If the input line ends a macro definition, update the macro context and return NULL */
+	/* If the input line ends a macro definition, update the macro context */
 	if (strcmp(input[0], "endmacr") == 0) {
 		manager->is_macro_context = 0;
-		return NULL;
+		return SkippedLine;
 	}
 
-	/* If in the middle of a macro definition, add the line to the current macro's command list */
+	/* If in the middle of a macro definition, add the line to the current macro's lines */
 	if (manager->is_macro_context) {
-		for (i = 0; i < manager->macro_count; ++i) {
-			if (strcmp(manager->macro_names[i], manager->current_macro_name) == 0) {
-				Macro* macro = &manager->macros[i];
-				macro->commands = realloc(macro->commands, (macro->row_count + 1) * sizeof(char**));
-				if (macro->commands == NULL) {
-					/* Handle allocation failure*/
-					log_error("process_file_line", 46, "macro_manager.c", "Memory allocation failed");
-					return NULL;
-				}
-				macro->commands[macro->row_count] = malloc((input_count + 1) * sizeof(char*));
-				if (macro->commands[macro->row_count] == NULL) {
-					/* Handle allocation failure*/
-					log_error("process_file_line", 52, "macro_manager.c", "Memory allocation failed");
-					return NULL;
-				}
-				for (j = 0; j < input_count; ++j) {
-					macro->commands[macro->row_count][j] = malloc((strlen(input[j]) + 1) * sizeof(char));
-					if (macro->commands[macro->row_count][j] == NULL) {
-						/* Handle allocation failure*/
-						log_error("process_file_line", 59, "macro_manager.c", "Memory allocation failed");
-						return NULL;
-					}
-					strcpy(macro->commands[macro->row_count][j], input[j]);
-				}
-				macro->commands[macro->row_count][input_count] = NULL; /* Null-terminate the row*/
-				macro->row_count++;
-				return NULL;
+		Macro* macro = &manager->macros[manager->current_macro];
+		if (macro->row_count == macro->row_size) {
+			int new_size = macro->row_size ? macro->row_size * 2 : MACRO_LINES_INITIAL_SIZE;
+			long* new_lines = (long*)resize_memory(manager->allocator, macro->lines, new_size * sizeof(long));
+			if (new_lines == NULL) {
+				/* Handle allocation failure*/
+				log_error("process_file_line", 146, "macro_manager.c", "Memory allocation failed");
+				return SkippedLine;
 			}
+			macro->lines = new_lines;
+			macro->row_size = new_size;
+		}
+		macro->lines[macro->row_count] = line_position;
+		macro->row_count++;
+		if (input_count > macro->width) {
+			macro->width = input_count;
 		}
+		return MacroLine;
 	}
 
 	/* If the input line defines a new macro, initialize it in the MacroManager */
 	if (strcmp(input[0], "macr") == 0) {
-		manager->is_macro_context = 1;
-		strcpy(manager->current_macro_name, input[1]);
-		manager->macro_names[manager->macro_count] = malloc((strlen(input[1]) + 1) * sizeof(char));
-		if (manager->macro_names[manager->macro_count] == NULL) {
-			/* Handle allocation failure*/
-			log_error("process_file_line", 78, "macro_manager.c", "Memory allocation failed");
-			return NULL;
+		if (input_count < 2) {
+			log_error("process_file_line", 160, "macro_manager.c", "Macro definition without a name");
+			return SkippedLine;
 		}
-		strcpy(manager->macro_names[manager->macro_count], input[1]);
-		manager->macros[manager->macro_count].commands = NULL;
-		manager->macros[manager->macro_count].row_count = 0;
-		manager->macro_count++;
-		return NULL;
-	}
-
-	for (i = 0; i < manager->macro_count; ++i) {
-		if (strcmp(manager->macro_names[i], input[0]) == 0) {
-			Macro* macro = &manager->macros[i];
-			char*** result = malloc((macro->row_count + 1) * sizeof(char**));
-			if (result == NULL) {
-				/* Handle allocation failure*/
-				log_error("process_file_line", 94, "macro_manager.c", "Memory allocation failed");
-				return NULL;
-			}
-			for (j = 0; j < macro->row_count; ++j) {
-				int k, row_length = 0;
-				for (k = 0; macro->commands[j][k] != NULL; ++k) {
-					row_length++;
-				}
-				result[j] = malloc((row_length + 1) * sizeof(char*));
-				if (result[j] == NULL) {
-					/* Handle allocation failure*/
-					log_error("process_file_line", 105, "macro_manager.c", "Memory allocation failed");
-					return NULL;
-				}
-				for (k = 0; macro->commands[j][k] != NULL; ++k) {
-					result[j][k] = malloc((strlen(macro->commands[j][k]) + 1) * sizeof(char));
-					if (result[j][k] == NULL) {
-						/* Handle allocation failure*/
-						log_error("process_file_line", 112, "macro_manager.c", "Memory allocation failed");
-						return NULL;
-					}
-					strcpy(result[j][k], macro->commands[j][k]);
-				}
-				result[j][row_length] = NULL; /* Null-terminate the row*/
+		manager->is_macro_context = 1;
+		/* A macro that is defined again gets the new lines after its old ones */
+		manager->current_macro = find_macro_index(manager, input[1]);
+		if (manager->current_macro < 0) {
+			manager->current_macro = add_macro(manager, input[1]);
+			if (manager->current_macro < 0) {
+				manager->is_macro_context = 0;
+				return SkippedLine;
 			}
-			result[macro->row_count] = NULL; /* Null-terminate the result array*/
-			return (char**)result;
 		}
+		/* The macro's name is interned, this line is not needed anymore */
+		return SkippedLine;
 	}
 
-
-	/* Allocate new memory for processed_line*/
-	processed_line = malloc((input_count + 1) * sizeof(char*));
-	if (processed_line == NULL) {
-		log_error("process_file_line", 128, "macro_manager.c", "Memory allocation failed");
-		return NULL;
-	}
-	for (i = 0; i < input_count; ++i) {
-		processed_line[i] = malloc((strlen(input[i]) + 1) * sizeof(char));
-		if (processed_line[i] == NULL) {
-			log_error("process_file_line", 134, "macro_manager.c", "Memory allocation failed");
-			return NULL;
-		}
-		strcpy(processed_line[i], input[i]);
-	}
-	processed_line[input_count] = NULL; /* Null-terminate the processed line*/
-
-	return processed_line;
+	/* A regular line, the caller keeps its tokens */
+	return ProgramLine;
 }
 
 /**
@@ -151,70 +147,19 @@ char** process_file_line(MacroManager* manager, char** input, int input_count) {
  * @return 1 if the name matches a macro name in the MacroManager, 0 otherwise.
  */
 int is_macro_name(MacroManager* manager, const char* name) {
-	int i;
-	for (i = 0; i < manager->macro_count; ++i) {
-		if (strcmp(manager->macro_names[i], name) == 0) {
-			return FOUND; /* Name matches a macro name*/
-		}
-	}
-	return NOT_FOUND; /*Name does not match any macro name*/
-}
-
-char*** get_macro_content(MacroManager* manager, const char* macro_name) {
-	int i, j;
-	for (i = 0; i < manager->macro_count; ++i) {
-		if (strcmp(manager->macro_names[i], macro_name) == 0) {
-			Macro* macro = &manager->macros[i];
-			char*** result = malloc((macro->row_count + 1) * sizeof(char**));
-			if (result == NULL) {
-				/* Handle allocation failure*/
-				return NULL;
-			}
-			for (j = 0; j < macro->row_count; ++j) {
-				int k, row_length = 0;
-				for (k = 0; macro->commands[j][k] != NULL; ++k) {
-					row_length++;
-				}
-				result[j] = malloc((row_length + 1) * sizeof(char*));
-				if (result[j] == NULL) {
-					/* Handle allocation failure*/
-					return NULL;
-				}
-				for (k = 0; macro->commands[j][k] != NULL; ++k) {
-					result[j][k] = malloc((strlen(macro->commands[j][k]) + 1) * sizeof(char));
-					if (result[j][k] == NULL) {
-						/* Handle allocation failure*/
-						return NULL;
-					}
-					strcpy(result[j][k], macro->commands[j][k]);
-				}
-				result[j][row_length] = NULL; /* Null-terminate the row*/
-			}
-			result[macro->row_count] = NULL; /* Null-terminate the result array*/
-			return result;
-		}
-	}
-	/* Return NULL if the macro_name was not found */
-	return NULL;
+	return find_macro_index(manager, name) >= 0 ? FOUND : NOT_FOUND;
 }
 
 /**
- * free_macro_manager -
- * Frees all dynamically allocated memory associated with the MacroManager.
+ * find_macro -
+ * Retrieves a macro by its name.
  *
- * @param manager A pointer to the MacroManager structure to be freed.
+ * @param manager A pointer to the MacroManager structure that contains the macros.
+ * @param name The name of the macro.
+ *
+ * @return The macro, owned by the MacroManager, or NULL if the name was not found.
  */
-void free_macro_manager(MacroManager* manager) {
-	int i, j, k;
-	for (i = 0; i < manager->macro_count; ++i) {
-		for (j = 0; j < manager->macros[i].row_count; ++j) {
-			for (k = 0; manager->macros[i].commands[j][k] != NULL; ++k) {
-				free(manager->macros[i].commands[j][k]);
-			}
-			free(manager->macros[i].commands[j]);
-		}
-		free(manager->macros[i].commands);
-		free(manager->macro_names[i]);
-	}
+const Macro* find_macro(const MacroManager* manager, const char* name) {
+	int index = find_macro_index(manager, name);
+	return index >= 0 ? &manager->macros[index] : NULL;
 }
-
@@ -8,30 +8,46 @@
 
 #include "constants.h"
 #include "error_manager.h"
+#include "memory_manager.h"
+#include "strings_manager.h"
+#include "atom_manager.h"
 
 
-#define MAX_STRING_LENGTH 100
-#define MAX_MACROS 100
+#define MACROS_INITIAL_SIZE 16
+#define MACRO_LINES_INITIAL_SIZE 4
 
 
+/* A macro's body is stored once and never copied: each of its lines is kept as a position
+ * given by the caller, the index of the line's first token in the FileManager's token table
+ * or the offset of the line in the source when the file is streamed*/
 typedef struct {
-    char*** commands;  /* Matrix of strings (commands)*/
-    int row_count;  /* Number of rows in the matrix*/
+    const char* name;  /* Name of the macro*/
+    long* lines;  /* Position of each line of the body*/
+    int row_count;  /* Number of lines in the body*/
+    int row_size;  /* Number of lines the body has room for*/
+    int width;  /* Most tokens in one line of the body*/
 } Macro;
 
+/* What the caller has to do with a line after the MacroManager processed it*/
+typedef enum LineKind {
+    ProgramLine,  /* A line of the program*/
+    MacroLine,  /* A line of a macro's body, the macro references its position*/
+    SkippedLine  /* An empty line, or the start or end of a macro definition*/
+} LineKind;
+
 typedef struct {
-    Macro macros[MAX_MACROS];
-    char* macro_names[MAX_MACROS];
+    Allocator* allocator;  /* Owner of the macros' memory*/
+    AtomTable names;  /* Names of the macros, the atom of a macro's name is its index in macros*/
+    Macro* macros;
     int macro_count;
+    int macro_size;
     int is_macro_context;
-    char current_macro_name[MAX_STRING_LENGTH];
+    int current_macro;  /* Index of the macro being defined*/
 } MacroManager;
 
-void init_macro_manager(MacroManager* manager);
-char** process_file_line(MacroManager* manager, char** input, int input_count);
-void free_macro_manager(MacroManager* manager);
-char*** get_macro_content(MacroManager* manager, const char* macro_name);
+void init_macro_manager(MacroManager* manager, Allocator* allocator);
+LineKind process_file_line(MacroManager* manager, char** input, int input_count, long line_position);
+const Macro* find_macro(const MacroManager* manager, const char* name);
 int is_macro_name(MacroManager* manager, const char* name);
 
-#endif /*MACRO_MANAGER_H*/ 
-
+#endif /*MACRO_MANAGER_H*/
@@ -0,0 +1,444 @@
+#include "memory_manager.h"
+
+/* Every allocation is preceded by a header holding its size, so it can be resized*/
+#define ARENA_HEADER_SIZE sizeof(ArenaAlign)
+#define ARENA_ROUND_UP(size) (((size) + sizeof(ArenaAlign) - 1) / sizeof(ArenaAlign) * sizeof(ArenaAlign))
+#define ARENA_SIZE_OF(ptr) (*(size_t*)((char*)(ptr) - ARENA_HEADER_SIZE))
+
+/* Links every live allocation of a system allocator, so release_allocator can free them*/
+struct SystemAllocation {
+	struct SystemAllocation* previous;
+	struct SystemAllocation* next;
+};
+#define SYSTEM_HEADER_SIZE ARENA_ROUND_UP(sizeof(struct SystemAllocation))
+
+static const char* allocator_names[] = { "system", "bump", "counting" };
+
+/**
+ * init_arena -
+ * Initializes an empty arena, no memory is taken until the first allocation.
+ *
+ * @param arena Pointer to the Arena structure to be initialized.
+ */
+void init_arena(Arena* arena) {
+	arena->blocks = NULL;
+	arena->last = NULL;
+	arena->total_size = 0;
+	arena->allocation_count = 0;
+}
+
+/**
+ * arena_alloc -
+ * Allocates memory from the arena.
+ * The memory is released only by release_arena.
+ *
+ * @param arena Pointer to the Arena structure.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated memory, or NULL if memory allocation fails.
+ */
+void* arena_alloc(Arena* arena, size_t size) {
+	ArenaBlock* block = arena->blocks;
+	size_t needed = ARENA_HEADER_SIZE + ARENA_ROUND_UP(size);
+	char* header;
+
+	/* Start a new block if the current one is full*/
+	if (block == NULL || block->size - block->used < needed) {
+		size_t block_size = needed > ARENA_BLOCK_SIZE ? needed : ARENA_BLOCK_SIZE;
+		block = (ArenaBlock*)malloc(sizeof(ArenaBlock) + block_size);
+		if (block == NULL) {
+			log_error("arena_alloc", 38, "memory_manager.c", "Memory allocation failed");
+			return NULL;
+		}
+		block->used = 0;
+		block->size = block_size;
+		block->next = arena->blocks;
+		arena->blocks = block;
+		arena->total_size += sizeof(ArenaBlock) + block_size;
+	}
+
+	arena->allocation_count++;
+	header = (char*)block->data + block->used;
+	*(size_t*)header = size;
+	block->used += needed;
+	arena->last = header + ARENA_HEADER_SIZE;
+	return arena->last;
+}
+
+/**
+ * arena_realloc -
+ * Resizes memory allocated from the arena.
+ * The most recent allocation grows in place when its block has room, otherwise the contents are moved.
+ *
+ * @param arena Pointer to the Arena structure.
+ * @param ptr The memory to resize, or NULL to allocate new memory.
+ * @param size The new size in bytes.
+ * @return A pointer to the resized memory, or NULL if memory allocation fails (ptr is left untouched).
+ */
+void* arena_realloc(Arena* arena, void* ptr, size_t size) {
+	size_t old_size;
+	void* new_ptr;
+
+	if (ptr == NULL) {
+		return arena_alloc(arena, size);
+	}
+
+	old_size = ARENA_SIZE_OF(ptr);
+	if (size <= old_size) {
+		return ptr;
+	}
+
+	/* The last allocation of the current block can simply take more of the block*/
+	if (ptr == arena->last) {
+		ArenaBlock* block = arena->blocks;
+		size_t offset = (size_t)((char*)ptr - (char*)block->data);
+		if (offset + ARENA_ROUND_UP(size) <= block->size) {
+			block->used = offset + ARENA_ROUND_UP(size);
+			ARENA_SIZE_OF(ptr) = size;
+			return ptr;
+		}
+	}
+
+	new_ptr = arena_alloc(arena, size);
+	if (new_ptr == NULL) {
+		return NULL;
+	}
+	memcpy(new_ptr, ptr, old_size);
+	return new_ptr;
+}
+
+/**
+ * release_arena -
+ * Frees all the memory allocated from the arena and leaves it empty and ready for reuse.
+ *
+ * @param arena Pointer to the Arena structure to be released.
+ */
+void release_arena(Arena* arena) {
+	ArenaBlock* block = arena->blocks;
+	while (block != NULL) {
+		ArenaBlock* next = block->next;
+		free(block);
+		block = next;
+	}
+	init_arena(arena);
+}
+
+/**
+ * system_allocate -
+ * Allocates memory with malloc, linked to the allocator's live allocations.
+ *
+ * @param allocator Pointer to the system Allocator.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated memory, or NULL if memory allocation fails.
+ */
+static void* system_allocate(Allocator* allocator, size_t size) {
+	struct SystemAllocation* header = (struct SystemAllocation*)malloc(SYSTEM_HEADER_SIZE + size);
+	if (header == NULL) {
+		log_error("system_allocate", 161, "memory_manager.c", "Memory allocation failed");
+		return NULL;
+	}
+	header->previous = NULL;
+	header->next = allocator->allocations;
+	if (header->next != NULL) {
+		header->next->previous = header;
+	}
+	allocator->allocations = header;
+	return (char*)header + SYSTEM_HEADER_SIZE;
+}
+
+/**
+ * system_resize -
+ * Resizes memory with realloc, keeping it linked to the allocator's live allocations.
+ *
+ * @param allocator Pointer to the system Allocator.
+ * @param ptr The memory to resize, or NULL to allocate new memory.
+ * @param size The new size in bytes.
+ * @return A pointer to the resized memory, or NULL if memory allocation fails (ptr is left untouched).
+ */
+static void* system_resize(Allocator* allocator, void* ptr, size_t size) {
+	struct SystemAllocation* header;
+
+	if (ptr == NULL) {
+		return system_allocate(allocator, size);
+	}
+
+	header = (struct SystemAllocation*)realloc((char*)ptr - SYSTEM_HEADER_SIZE, SYSTEM_HEADER_SIZE + size);
+	if (header == NULL) {
+		log_error("system_resize", 191, "memory_manager.c", "Memory allocation failed");
+		return NULL;
+	}
+
+	/* The neighbours point to where the allocation is now*/
+	if (header->previous != NULL) {
+		header->previous->next = header;
+	}
+	else {
+		allocator->allocations = header;
+	}
+	if (header->next != NULL) {
+		header->next->previous = header;
+	}
+	return (char*)header + SYSTEM_HEADER_SIZE;
+}
+
+/**
+ * system_release -
+ * Frees memory taken by system_allocate or system_resize.
+ *
+ * @param allocator Pointer to the system Allocator.
+ * @param ptr The memory to free, or NULL.
+ */
+static void system_release(Allocator* allocator, void* ptr) {
+	struct SystemAllocation* header;
+
+	if (ptr == NULL) {
+		return;
+	}
+
+	header = (struct SystemAllocation*)((char*)ptr - SYSTEM_HEADER_SIZE);
+	if (header->previous != NULL) {
+		header->previous->next = header->next;
+	}
+	else {
+		allocator->allocations = header->next;
+	}
+	if (header->next != NULL) {
+		header->next->previous = header->previous;
+	}
+	free(header);
+}
+
+/**
+ * bump_allocate -
+ * Allocates memory from the allocator's arena.
+ *
+ * @param allocator Pointer to the bump Allocator.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated memory, or NULL if memory allocation fails.
+ */
+static void* bump_allocate(Allocator* allocator, size_t size) {
+	return arena_alloc(allocator->arena, size);
+}
+
+/**
+ * bump_resize -
+ * Resizes memory allocated from the allocator's arena.
+ *
+ * @param allocator Pointer to the bump Allocator.
+ * @param ptr The memory to resize, or NULL to allocate new memory.
+ * @param size The new size in bytes.
+ * @return A pointer to the resized memory, or NULL if memory allocation fails (ptr is left untouched).
+ */
+static void* bump_resize(Allocator* allocator, void* ptr, size_t size) {
+	return arena_realloc(allocator->arena, ptr, size);
+}
+
+/**
+ * arena_release_last -
+ * Gives the most recent allocation of an arena back to its block, other memory stays until release_arena.
+ *
+ * @param arena Pointer to the Arena structure.
+ * @param ptr The memory that is not used anymore.
+ */
+static void arena_release_last(Arena* arena, void* ptr) {
+	if (ptr != NULL && ptr == arena->last) {
+		arena->blocks->used = (size_t)((char*)ptr - (char*)arena->blocks->data) - ARENA_HEADER_SIZE;
+		arena->last = NULL;
+	}
+}
+
+/**
+ * bump_release -
+ * Takes back the memory if it is the arena's most recent allocation, the rest of the
+ * arena's memory is released all at once by release_allocator.
+ *
+ * @param allocator Pointer to the bump Allocator.
+ * @param ptr The memory that is not used anymore, or NULL.
+ */
+static void bump_release(Allocator* allocator, void* ptr) {
+	arena_release_last(allocator->arena, ptr);
+}
+
+/**
+ * count_bytes -
+ * Counts bytes that were just handed out by a counting allocator.
+ *
+ * @param counts The counts of the allocator.
+ * @param size The number of bytes handed out.
+ */
+static void count_bytes(AllocatorCounts* counts, size_t size) {
+	counts->allocations++;
+	counts->bytes += size;
+	counts->live_bytes += size;
+	if (counts->live_bytes > counts->peak_bytes) {
+		counts->peak_bytes = counts->live_bytes;
+	}
+}
+
+/**
+ * counting_allocate -
+ * Allocates memory from the allocator's arena and counts it.
+ *
+ * @param allocator Pointer to the counting Allocator.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated memory, or NULL if memory allocation fails.
+ */
+static void* counting_allocate(Allocator* allocator, size_t size) {
+	void* ptr = arena_alloc(allocator->arena, size);
+	if (ptr != NULL) {
+		count_bytes(&allocator->counts, size);
+	}
+	return ptr;
+}
+
+/**
+ * counting_resize -
+ * Resizes memory allocated from the allocator's arena and counts the bytes it grew by.
+ *
+ * @param allocator Pointer to the counting Allocator.
+ * @param ptr The memory to resize, or NULL to allocate new memory.
+ * @param size The new size in bytes.
+ * @return A pointer to the resized memory, or NULL if memory allocation fails (ptr is left untouched).
+ */
+static void* counting_resize(Allocator* allocator, void* ptr, size_t size) {
+	size_t old_size = ptr != NULL ? ARENA_SIZE_OF(ptr) : 0;
+	void* new_ptr = arena_realloc(allocator->arena, ptr, size);
+	if (new_ptr != NULL) {
+		count_bytes(&allocator->counts, size > old_size ? size - old_size : 0);
+	}
+	return new_ptr;
+}
+
+/**
+ * counting_release -
+ * Counts that memory is not used anymore, and releases it as bump_release does.
+ *
+ * @param allocator Pointer to the counting Allocator.
+ * @param ptr The memory that is not used anymore, or NULL.
+ */
+static void counting_release(Allocator* allocator, void* ptr) {
+	if (ptr != NULL) {
+		allocator->counts.live_bytes -= ARENA_SIZE_OF(ptr);
+		arena_release_last(allocator->arena, ptr);
+	}
+}
+
+/**
+ * init_allocator -
+ * Initializes an allocator of the given kind, nothing is taken until the first allocation.
+ *
+ * @param allocator Pointer to the Allocator to initialize.
+ * @param kind Where the allocator takes its memory.
+ * @param arena The initialized arena a bump or counting allocator takes its memory from, not used by a system allocator.
+ */
+void init_allocator(Allocator* allocator, AllocatorKind kind, Arena* arena) {
+	allocator->kind = kind;
+	allocator->arena = arena;
+	allocator->allocations = NULL;
+	allocator->counts.allocations = 0;
+	allocator->counts.bytes = 0;
+	allocator->counts.live_bytes = 0;
+	allocator->counts.peak_bytes = 0;
+
+	if (kind == SystemAllocator) {
+		allocator->allocate = system_allocate;
+		allocator->resize = system_resize;
+		allocator->release = system_release;
+	}
+	else if (kind == CountingAllocator) {
+		allocator->allocate = counting_allocate;
+		allocator->resize = counting_resize;
+		allocator->release = counting_release;
+	}
+	else {
+		allocator->allocate = bump_allocate;
+		allocator->resize = bump_resize;
+		allocator->release = bump_release;
+	}
+}
+
+/**
+ * allocate_memory -
+ * Allocates memory from an allocator.
+ *
+ * @param allocator Pointer to the Allocator.
+ * @param size The number of bytes to allocate.
+ * @return A pointer to the allocated memory, or NULL if memory allocation fails.
+ */
+void* allocate_memory(Allocator* allocator, size_t size) {
+	return allocator->allocate(allocator, size);
+}
+
+/**
+ * resize_memory -
+ * Resizes memory allocated from an allocator, like realloc.
+ *
+ * @param allocator Pointer to the Allocator the memory was taken from.
+ * @param ptr The memory to resize, or NULL to allocate new memory.
+ * @param size The new size in bytes.
+ * @return A pointer to the resized memory, or NULL if memory allocation fails (ptr is left untouched).
+ */
+void* resize_memory(Allocator* allocator, void* ptr, size_t size) {
+	return allocator->resize(allocator, ptr, size);
+}
+
+/**
+ * release_memory -
+ * Tells an allocator that memory is not used anymore. An arena keeps it until release_allocator.
+ *
+ * @param allocator Pointer to the Allocator the memory was taken from.
+ * @param ptr The memory to release, or NULL.
+ */
+void release_memory(Allocator* allocator, void* ptr) {
+	allocator->release(allocator, ptr);
+}
+
+/**
+ * release_allocator -
+ * Frees all the memory still taken from an allocator, and leaves it empty and ready for reuse.
+ * The counts are kept, so they can be read once the memory is released.
+ *
+ * @param allocator Pointer to the Allocator to release.
+ */
+void release_allocator(Allocator* allocator) {
+	struct SystemAllocation* header = allocator->allocations;
+	while (header != NULL) {
+		struct SystemAllocation* next = header->next;
+		free(header);
+		header = next;
+	}
+	allocator->allocations = NULL;
+	allocator->counts.live_bytes = 0;
+	if (allocator->arena != NULL) {
+		release_arena(allocator->arena);
+	}
+}
+
+/**
+ * find_allocator_kind -
+ * Reads the name of an allocator.
+ *
+ * @param name system, bump or counting.
+ * @param kind Set to the kind of allocator with this name.
+ * @return FOUND if the name is known, NOT_FOUND otherwise.
+ */
+int find_allocator_kind(const char* name, AllocatorKind* kind) {
+	int index;
+	for (index = SystemAllocator; index <= CountingAllocator; index++) {
+		if (strcmp(name, allocator_names[index]) == 0) {
+			*kind = (AllocatorKind)index;
+			return FOUND;
+		}
+	}
+	return NOT_FOUND;
+}
+
+/**
+ * allocator_name -
+ * Gives the name an allocator is chosen by.
+ *
+ * @param kind The kind of allocator.
+ * @return The name of the allocator.
+ */
+const char* allocator_name(AllocatorKind kind) {
+	return allocator_names[kind];
+}
@@ -0,0 +1,83 @@
+#ifndef MEMORY_MANAGER_H
+#define MEMORY_MANAGER_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "constants.h"
+#include "error_manager.h"
+
+#define ARENA_BLOCK_SIZE 65536
+
+/* The allocator files are assembled with, unless --allocator chooses another one*/
+#ifndef DEFAULT_ALLOCATOR
+#define DEFAULT_ALLOCATOR BumpAllocator
+#endif
+
+/* Every allocation is aligned to the strictest of these types*/
+typedef union {
+	long l;
+	double d;
+	void* p;
+} ArenaAlign;
+
+typedef struct ArenaBlock {
+	struct ArenaBlock* next; /* The block that was filled before this one*/
+	size_t used;             /* Bytes of data already handed out*/
+	size_t size;             /* Bytes of data in the block*/
+	ArenaAlign data[1];      /* Start of the block's data*/
+} ArenaBlock;
+
+/* An arena owns all the memory of one assembled file and releases it in one call*/
+typedef struct {
+	ArenaBlock* blocks;  /* The current block, older blocks are linked through next*/
+	void* last;          /* The most recent allocation, it can grow in place*/
+	size_t total_size;   /* Bytes taken from the system by the arena*/
+	unsigned long allocation_count; /* Allocations handed out by the arena*/
+} Arena;
+
+/* Where an Allocator takes its memory*/
+typedef enum AllocatorKind {
+	SystemAllocator,    /* malloc, realloc and free for every allocation*/
+	BumpAllocator,      /* An arena, released in one call*/
+	CountingAllocator   /* An arena, counting what is asked of it*/
+} AllocatorKind;
+
+/* What a counting allocator was asked for*/
+typedef struct {
+	unsigned long allocations; /* Allocations and resizes*/
+	size_t bytes;              /* Bytes allocated, and added by resizes*/
+	size_t live_bytes;         /* Bytes allocated and not released yet*/
+	size_t peak_bytes;         /* Most live_bytes at one time*/
+} AllocatorCounts;
+
+struct SystemAllocation;
+typedef struct Allocator Allocator;
+
+/* The memory the managers use is taken through an Allocator, so where it comes from can be chosen per file.
+ * Whatever was not released one allocation at a time is released by release_allocator*/
+struct Allocator {
+	void* (*allocate)(Allocator* allocator, size_t size);
+	void* (*resize)(Allocator* allocator, void* ptr, size_t size);
+	void (*release)(Allocator* allocator, void* ptr);
+	AllocatorKind kind;
+	Arena* arena;                         /* The memory of a bump or counting allocator*/
+	struct SystemAllocation* allocations; /* The live allocations of a system allocator*/
+	AllocatorCounts counts;               /* Kept by a counting allocator*/
+};
+
+void init_arena(Arena* arena);
+void* arena_alloc(Arena* arena, size_t size);
+void* arena_realloc(Arena* arena, void* ptr, size_t size);
+void release_arena(Arena* arena);
+
+void init_allocator(Allocator* allocator, AllocatorKind kind, Arena* arena);
+void* allocate_memory(Allocator* allocator, size_t size);
+void* resize_memory(Allocator* allocator, void* ptr, size_t size);
+void release_memory(Allocator* allocator, void* ptr);
+void release_allocator(Allocator* allocator);
+int find_allocator_kind(const char* name, AllocatorKind* kind);
+const char* allocator_name(AllocatorKind kind);
+
+#endif /* MEMORY_MANAGER_H*/
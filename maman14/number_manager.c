@@ -1,146 +1,83 @@
 #include "number_manager.h"
 
+/* The two digits of every number below 100*/
+static const char decimal_pairs[] =
+	"0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+	"5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+/* The two octal digits of every 6-bit value*/
+static const char octal_pairs[] =
+	"0001020304050607101112131415161720212223242526273031323334353637"
+	"4041424344454647505152535455565760616263646566677071727374757677";
+
 /**
- * intTo12BitUnsignedString - 
- * Converts an unsigned integer to a 12-bit binary string representation.
+ * intTo12BitUnsigned - 
+ * Converts an unsigned integer to a 12-bit unsigned value.
  *
  * @param num The unsigned integer to convert.
- * @return A pointer to a null-terminated string containing the binary representation.
- *         Returns NULL if the input number is out of range or memory allocation fails.
+ * @return The 12-bit value, or NO_WORD if the input number is out of range.
  */
-char* intTo12BitUnsignedString(unsigned int num) {
-	unsigned int mask;
-	int i;
-	char* binaryString;
+Word intTo12BitUnsigned(unsigned int num) {
 	if (num > 4095) {
-		return NULL;
-	}
-	binaryString = (char*)malloc(BITS + 1);
-	if (!binaryString) {
-		return NULL;
+		return NO_WORD;
 	}
-	binaryString[BITS] = '\0';
-	mask = 1 << (BITS - 1);
-	for (i = 0; i < BITS; i++) {
-		binaryString[i] = (num & mask) ? '1' : '0';
-		mask >>= 1;
-	}
-	return binaryString;
+	return (Word)num;
 }
 
 /**
- * intTo12Bit2ComplementString -
- * Converts an integer to a 12-bit two's complement binary string representation.
+ * intTo12Bit2Complement -
+ * Converts an integer to its 12-bit two's complement value.
  *
  * @param num The integer to convert.
- * @return A pointer to a null-terminated string containing the binary representation.
- *         Returns NULL if the input number is out of range or memory allocation fails.
+ * @return The 12-bit value, or NO_WORD if the input number is out of range.
  */
-char* intTo12Bit2ComplementString(int num) {
-	int i;
-	unsigned int mask;	
-	char* binaryString; 	
+Word intTo12Bit2Complement(int num) {
 	if (num < -2048 || num > 2047) {
-		return NULL;
-	}
-	binaryString = (char*)malloc(BITS + 1);
-	if (!binaryString) {
-		return NULL;
+		return NO_WORD;
 	}
-	binaryString[BITS] = '\0';
-	mask = 1 << (BITS - 1);
-	for (i = 0; i < BITS; i++) {
-		binaryString[i] = (num & mask) ? '1' : '0';
-		mask >>= 1;
-	}
-	return binaryString;
+	return (Word)((unsigned int)num & 0xFFF);
 }
 
 /**
- * intToThreeBitBinary -
- * Converts an integer to a 3-bit binary string representation.
+ * intToThreeBit -
+ * Converts an integer to a 3-bit value.
  *
  * @param num The integer to convert (must be between 0 and 7 inclusive).
- * @return A pointer to a null-terminated string containing the binary representation.
- *         Returns NULL if the input number is out of range or memory allocation fails.
+ * @return The 3-bit value, or NO_WORD if the input number is out of range.
  */
-char* intToThreeBitBinary(int num) {
-	char* binaryString;
+Word intToThreeBit(int num) {
 	if (num < 0 || num > 7) {
-		return NULL;
-	}
-	binaryString = (char*)malloc(4);
-	if (!binaryString) {
-		return NULL;
+		return NO_WORD;
 	}
-	binaryString[0] = (num & 4) ? '1' : '0';
-	binaryString[1] = (num & 2) ? '1' : '0';
-	binaryString[2] = (num & 1) ? '1' : '0';
-	binaryString[3] = '\0';
-	return binaryString;
+	return (Word)num;
 }
 
 /**
- * intTo4BitString -
- * Converts an integer to a 4-bit binary string representation.
+ * intTo4Bit -
+ * Converts an integer to a 4-bit value.
  *
  * @param number The integer to convert (must be between 0 and 15 inclusive).
- * @return A pointer to a null-terminated string containing the 4-bit binary representation.
- *         Returns NULL if the input number is out of range or memory allocation fails.
+ * @return The 4-bit value, or NO_WORD if the input number is out of range.
  */
-char* intTo4BitString(int number) {
-	int i;
-	char* bitString; 
+Word intTo4Bit(int number) {
 	if (number < 0 || number > WORD_SIZE_IN_BITS) {
-		return NULL;
-	}
-	bitString = (char*)malloc(5);
-	if (!bitString) {
-		return NULL;
-	}
-	for (i = 3; i >= 0; i--) {
-		bitString[3 - i] = (number & (1 << i)) ? '1' : '0';
+		return NO_WORD;
 	}
-	bitString[4] = '\0';
-	return bitString;
+	return (Word)number;
 }
 
 /**
  * int_to_15bit_twos_complement -
- * Converts an integer to a 15-bit two's complement binary string representation.
+ * Converts an integer to its 15-bit two's complement value.
  *
  * @param number The integer to convert (must be between -16384 and 16383 inclusive).
- * @return A pointer to a null-terminated string containing the 15-bit two's complement representation.
- *         Returns NULL if memory allocation fails or if the number is out of range.
+ * @return The 15-bit two's complement word, or NO_WORD if the number is out of range.
  */
-char* int_to_15bit_twos_complement(int number) {
-	char* result = (char*)malloc((WORD_SIZE_IN_BITS+1) * sizeof(char));
-	int i;
-	unsigned short twos_complement;
-
-	if (result == NULL) {
-		log_error("int_to_15bit_twos_complement", 122, "number_manager.c", "Memory allocation failed");
-				return NULL;
-	}
-
+Word int_to_15bit_twos_complement(int number) {
 	if (number < -16384 || number > 16383) {
-		free(result);
-		return NULL;
-	}
-
-	if (number < 0) {
-		twos_complement = (unsigned short)((~(-number) + 1) & 0x7FFF);
-	}
-	else {
-		twos_complement = (unsigned short)(number & 0x7FFF);
+		return NO_WORD;
 	}
-
-	for (i = (WORD_SIZE_IN_BITS-1); i >= 0; i--) {
-		result[(WORD_SIZE_IN_BITS-1) - i] = (twos_complement & (1 << i)) ? '1' : '0';
-	}
-	result[WORD_SIZE_IN_BITS] = '\0';
-
-	return result;
+	return (Word)((unsigned int)number & WORD_MASK);
 }
 
 /**
@@ -159,51 +96,81 @@ int calc_array_length(char** array) {
 }
 
 /**
- * bitStringToOctal -
- * Converts a binary string to its octal representation.
+ * format_decimal -
+ * Writes the decimal digits of a number, two digits at a time.
+ * The buffer is not null-terminated.
  *
- * @param bitString A null-terminated string representing a binary number.
- * @return A pointer to a null-terminated string containing the octal representation.
- *         Returns NULL if memory allocation fails.
+ * @param buffer The buffer to write to, it must have room for the digits and the sign of an int.
+ * @param number The number to write.
+ * @return The number of characters written.
  */
-char* bitStringToOctal(const char* bitString) {
-	unsigned int decimal = 0;
-	unsigned int octal = 0, place = 1;
-	char* octalString = (char*)malloc(6 * sizeof(char)); /* 5 chars + 1 null terminator*/
-	int i, j;
-
-	if (octalString == NULL) {
-		return NULL;  /* Return NULL if memory allocation fails*/
+int format_decimal(char* buffer, int number) {
+	char digits[12]; /* The digits of an int, from the end*/
+	unsigned long value = number < 0 ? 0UL - (unsigned long)number : (unsigned long)number;
+	int count = 0;
+	int length = 0;
+
+	while (value >= 100) {
+		const char* pair = &decimal_pairs[(value % 100) * 2];
+		digits[count++] = pair[1];
+		digits[count++] = pair[0];
+		value /= 100;
+	}
+	if (value >= 10) {
+		digits[count++] = decimal_pairs[value * 2 + 1];
+		digits[count++] = decimal_pairs[value * 2];
 	}
-
-	/* Convert the bit string to a decimal number*/
-	for (i = 0; i < WORD_SIZE_IN_BITS; i++) {
-		if (bitString[i] == '1') {
-			decimal += (1U << ((WORD_SIZE_IN_BITS-1) - i));
-		}
+	else {
+		digits[count++] = (char)('0' + value);
 	}
 
-	/* Convert the decimal number to octal*/
-	while (decimal > 0) {
-		octal += (decimal % 8) * place;
-		decimal /= 8;
-		place *= 10;
+	if (number < 0) {
+		buffer[length++] = '-';
 	}
-
-	/* Convert the octal number to a string*/
-	for (i = 4; i >= 0; i--) {
-		octalString[i] = '0' + (octal % 10);
-		octal /= 10;
+	while (count > 0) {
+		buffer[length++] = digits[--count];
 	}
-	octalString[5] = '\0';
+	return length;
+}
 
-	/* If octal number is less than 5 digits, pad with leading zeros*/
-	for (j = 0; j < 5; j++) {
-		if (octalString[j] != '0') {
-			break;
-		}
-		octalString[j] = '0';
-	}
+/**
+ * format_octal_word -
+ * Writes the OCTAL_WORD_LENGTH octal digits of a word, with leading zeros.
+ * The buffer is not null-terminated.
+ *
+ * @param buffer The buffer to write to.
+ * @param word The word to write, only its WORD_SIZE_IN_BITS bits are written.
+ * @return The number of characters written.
+ */
+int format_octal_word(char* buffer, Word word) {
+	const char* pair;
+	unsigned int value = word & WORD_MASK;
+
+	/* 3 bits for the first digit, then two digits for every 6 bits*/
+	buffer[0] = (char)('0' + (value >> 12));
+	pair = &octal_pairs[((value >> 6) & 077) * 2];
+	buffer[1] = pair[0];
+	buffer[2] = pair[1];
+	pair = &octal_pairs[(value & 077) * 2];
+	buffer[3] = pair[0];
+	buffer[4] = pair[1];
+	return OCTAL_WORD_LENGTH;
+}
 
-	return octalString;
+/**
+ * format_object_line -
+ * Writes a line of the object file: the location, a tab, the octal word and a newline.
+ * The buffer is not null-terminated.
+ *
+ * @param buffer The buffer to write to, it must have room for OBJECT_LINE_MAX_LENGTH characters.
+ * @param location The location of the word.
+ * @param word The word.
+ * @return The number of characters written.
+ */
+int format_object_line(char* buffer, int location, Word word) {
+	int length = format_decimal(buffer, location);
+	buffer[length++] = '\t';
+	length += format_octal_word(buffer + length, word);
+	buffer[length++] = '\n';
+	return length;
 }
@@ -10,21 +10,45 @@
 
 #define BITS 12
 
-/* Convert an unsigned int to a 12-bit unsigned string*/
-char* intTo12BitUnsignedString(unsigned int num);
+/* A machine word, only its low WORD_SIZE_IN_BITS bits are used (C90 has no uint16_t)*/
+typedef unsigned short Word;
 
-/* Convert an int to a 12-bit two's complement string*/
-char* intTo12Bit2ComplementString(int num);
+#define WORD_MASK 0x7FFF /* The WORD_SIZE_IN_BITS bits of a word*/
+#define NO_WORD 0xFFFF   /* Not a machine word, returned when a value can't be encoded*/
 
-/* Convert an int to a 3-bit binary string*/
-char* intToThreeBitBinary(int num);
+/* The ARE bits, the 3 lowest bits of every word of an instruction*/
+#define ARE_BITS 3
+#define ARE_ABSOLUTE 4
+#define ARE_RELOCATABLE 2
+#define ARE_EXTERNAL 1
 
-/* Convert an int to a 4-bit string*/
-char* intTo4BitString(int number);
+/* Convert an unsigned int to a 12-bit unsigned value*/
+Word intTo12BitUnsigned(unsigned int num);
 
-char* int_to_15bit_twos_complement(int number);
+/* Convert an int to a 12-bit two's complement value*/
+Word intTo12Bit2Complement(int num);
+
+/* Convert an int to a 3-bit value*/
+Word intToThreeBit(int num);
+
+/* Convert an int to a 4-bit value*/
+Word intTo4Bit(int number);
+
+Word int_to_15bit_twos_complement(int number);
 
 int calc_array_length(char** array);
 
-char* bitStringToOctal(const char* bitString);
+#define DECIMAL_MAX_LENGTH 11     /* The digits and the sign of an int*/
+#define OCTAL_WORD_LENGTH 5       /* Octal digits of a word*/
+#define OBJECT_LINE_MAX_LENGTH 20 /* A location, a tab, the octal digits of a word and a newline*/
+
+/* Write the decimal digits of a number to a buffer*/
+int format_decimal(char* buffer, int number);
+
+/* Write the octal digits of a word to a buffer*/
+int format_octal_word(char* buffer, Word word);
+
+/* Write a line of the object file to a buffer*/
+int format_object_line(char* buffer, int location, Word word);
+
 #endif /*NUMBER_MANAGER_H*/
@@ -0,0 +1,209 @@
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#define OUTPUT_USE_POSIX
+#endif
+
+#include "output_manager.h"
+
+#ifdef OUTPUT_USE_POSIX
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+/**
+ * is_same_file -
+ * Checks if a file already holds exactly the given contents.
+ *
+ * @param file_path The path of the file.
+ * @param data The contents to compare with.
+ * @param length The number of characters in data.
+ * @return FOUND if the file exists with the same contents, NOT_FOUND otherwise.
+ */
+static int is_same_file(const char* file_path, const char* data, size_t length) {
+	char buffer[OUTPUT_COMPARE_SIZE];
+	size_t compared = 0;
+#ifdef OUTPUT_USE_POSIX
+	struct stat file_stat;
+	ssize_t count;
+	int fd = open(file_path, O_RDONLY);
+	if (fd < 0) {
+		return NOT_FOUND;
+	}
+	/* A file of another size can't be the same*/
+	if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) || (size_t)file_stat.st_size != length) {
+		close(fd);
+		return NOT_FOUND;
+	}
+	while (compared < length && (count = read(fd, buffer, sizeof(buffer))) > 0) {
+		if ((size_t)count > length - compared || memcmp(buffer, data + compared, (size_t)count) != 0) {
+			break;
+		}
+		compared += (size_t)count;
+	}
+	close(fd);
+#else
+	size_t count;
+	FILE* file = fopen(file_path, "r");
+	if (file == NULL) {
+		return NOT_FOUND;
+	}
+	while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+		if (count > length - compared || memcmp(buffer, data + compared, count) != 0) {
+			fclose(file);
+			return NOT_FOUND;
+		}
+		compared += count;
+	}
+	fclose(file);
+#endif
+	return compared == length ? FOUND : NOT_FOUND;
+}
+
+/* Numbers the temporary files of this process, so two writers never share one*/
+static unsigned long temp_count = 0;
+
+/**
+ * next_temp_number -
+ * Gives the next number of a temporary file of this process.
+ *
+ * @return A number no other temporary file of this process was given.
+ */
+static unsigned long next_temp_number(void) {
+#ifdef USE_THREADS
+	return __atomic_fetch_add(&temp_count, 1, __ATOMIC_RELAXED);
+#else
+	return temp_count++;
+#endif
+}
+
+/**
+ * write_temp_file -
+ * Writes the whole contents to a new temporary file next to the output, in one write when the system allows it.
+ * The file is given a name no other file has, so writers of the same output never write to the same file.
+ * Nothing is left behind if the contents can't be written.
+ *
+ * @param temp_path Starts with the path of the output file, its suffix is added after it. It must have
+ * room for OUTPUT_TEMP_SUFFIX_SIZE more characters.
+ * @param path_length The length of the path of the output file.
+ * @param data The contents to write.
+ * @param length The number of characters in data.
+ * @return FOUND if everything was written, NOT_FOUND otherwise.
+ */
+static int write_temp_file(char* temp_path, size_t path_length, const char* data, size_t length) {
+	int attempt;
+#ifdef OUTPUT_USE_POSIX
+	ssize_t count;
+	int fd = -1;
+	/* The process id keeps other assemblers out, the number keeps out the other jobs of this one*/
+	for (attempt = 0; attempt < OUTPUT_TEMP_ATTEMPTS && fd < 0; attempt++) {
+		sprintf(temp_path + path_length, ".%ld-%lu%s", (long)getpid(), next_temp_number(), OUTPUT_TEMP_EXTENSION);
+		fd = open(temp_path, O_WRONLY | O_CREAT | O_EXCL, 0666);
+		if (fd < 0 && errno != EEXIST) {
+			return NOT_FOUND;
+		}
+	}
+	if (fd < 0) {
+		return NOT_FOUND;
+	}
+	/* A regular file takes everything in one write, the loop only guards against signals*/
+	while (length > 0) {
+		count = write(fd, data, length);
+		if (count < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			close(fd);
+			remove(temp_path);
+			return NOT_FOUND;
+		}
+		data += count;
+		length -= (size_t)count;
+	}
+	if (close(fd) != 0) {
+		remove(temp_path);
+		return NOT_FOUND;
+	}
+	return FOUND;
+#else
+	int result;
+	FILE* file = NULL;
+	/* Without a way to create a file only if it is new, skip the names that are taken*/
+	for (attempt = 0; attempt < OUTPUT_TEMP_ATTEMPTS && file == NULL; attempt++) {
+		sprintf(temp_path + path_length, ".%lu%s", next_temp_number(), OUTPUT_TEMP_EXTENSION);
+		file = fopen(temp_path, "r");
+		if (file != NULL) {
+			fclose(file);
+			file = NULL;
+		}
+		else {
+			file = fopen(temp_path, "w");
+			if (file == NULL) {
+				return NOT_FOUND;
+			}
+		}
+	}
+	if (file == NULL) {
+		return NOT_FOUND;
+	}
+	result = fwrite(data, 1, length, file) == length;
+	if (fclose(file) != 0) {
+		result = NOT_FOUND;
+	}
+	if (!result) {
+		remove(temp_path);
+	}
+	return result ? FOUND : NOT_FOUND;
+#endif
+}
+
+/**
+ * write_output_file -
+ * Writes an output file from its whole contents.
+ * The contents go to a temporary file of its own that is then renamed over the output, so the output
+ * is never left half written, even by two writers of the same output. If the output already holds
+ * the same contents, it is left untouched and keeps its modification time.
+ *
+ * @param file_name The base name of the file, without its extension.
+ * @param extension The extension of the output file.
+ * @param data The contents of the file.
+ * @param length The number of characters in data.
+ * @return FOUND if the output file holds the contents, NOT_FOUND otherwise.
+ */
+int write_output_file(const char* file_name, const char* extension, const char* data, size_t length) {
+	size_t name_length = strlen(file_name) + strlen(extension);
+	char* file_path = (char*)malloc(2 * name_length + OUTPUT_TEMP_SUFFIX_SIZE + 2);
+	char* temp_path;
+	int result = FOUND;
+
+	if (file_path == NULL) {
+		log_error("write_output_file", 129, "output_manager.c", "Memory allocation failed");
+		return NOT_FOUND;
+	}
+	strcpy(file_path, file_name);
+	strcat(file_path, extension);
+	temp_path = file_path + name_length + 1;
+	memcpy(temp_path, file_path, name_length);
+
+	if (!is_same_file(file_path, data, length)) {
+		if (!write_temp_file(temp_path, name_length, data, length)) {
+			file_error("write_output_file", 191, "output_manager.c", "Failed to write file", file_path);
+			result = NOT_FOUND;
+		}
+		else {
+#ifndef OUTPUT_USE_POSIX
+			/* rename does not replace an existing file everywhere*/
+			remove(file_path);
+#endif
+			if (rename(temp_path, file_path) != 0) {
+				file_error("write_output_file", 150, "output_manager.c", "Failed to open file", file_path);
+				remove(temp_path);
+				result = NOT_FOUND;
+			}
+		}
+	}
+	free(file_path);
+	return result;
+}
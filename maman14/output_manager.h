@@ -0,0 +1,18 @@
+#ifndef OUTPUT_MANAGER_H
+#define OUTPUT_MANAGER_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "constants.h"
+#include "error_manager.h"
+
+#define OUTPUT_COMPARE_SIZE 4096 /* Bytes of the existing file read at a time when comparing*/
+#define OUTPUT_TEMP_EXTENSION ".tmp"
+#define OUTPUT_TEMP_SUFFIX_SIZE 48 /* Room for ".<pid>-<number>.tmp" after the output's path*/
+#define OUTPUT_TEMP_ATTEMPTS 100   /* Names tried before giving up on a temporary file*/
+
+int write_output_file(const char* file_name, const char* extension, const char* data, size_t length);
+
+#endif /* OUTPUT_MANAGER_H*/
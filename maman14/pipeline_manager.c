@@ -0,0 +1,164 @@
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "pipeline_manager.h"
+
+/**
+ * expand_stage -
+ * Expands the macros of the stage's source, or of its file when it has no source.
+ *
+ * @param stage Pointer to the MacroStage of the file.
+ * @return FOUND if the macros were expanded, NOT_FOUND otherwise.
+ */
+static int expand_stage(MacroStage* stage) {
+	int result;
+	stage->start = stats_time();
+	if (stage->source != NULL) {
+		result = expand_source(stage->fileManager, stage->macroManager, stage->source);
+	}
+	else {
+		result = input_process(stage->fileManager, stage->macroManager, stage->file_name);
+	}
+	stage->seconds = stats_time() - stage->start;
+	return result;
+}
+
+#ifdef USE_THREADS
+#include <pthread.h>
+
+/**
+ * run_macro_stage -
+ * Thread entry that expands the macros of a file, handing every post-macro line to the queue.
+ *
+ * @param argument Pointer to the MacroStage of the file.
+ * @return NULL.
+ */
+static void* run_macro_stage(void* argument) {
+	MacroStage* stage = (MacroStage*)argument;
+	set_error_log(stage->errors);
+	stage->result = expand_stage(stage);
+	/* The first scan stops once it took every line*/
+	line_queue_close(stage->fileManager->queue);
+	return NULL;
+}
+#endif
+
+/**
+ * run_stages -
+ * Expands the macros of a file and performs the first scan of its lines.
+ * When threads are available, the first scan runs while the macros are still being expanded:
+ * each line is handed over through a queue as soon as it is added to the post-macro table.
+ * The managers of the two stages must use different allocators.
+ * A label can only be checked against the macros once all of them are known, so in that case
+ * the labels are checked after both stages are done.
+ *
+ * @param stage Pointer to the MacroStage of the file, with its managers and its source.
+ * @param assemblerManager A pointer to the AssemblerManager that keeps IC and DC.
+ * @param symbolsManager A pointer to the SymbolsManager that collects the symbols.
+ * @param stats Receives the time of the two stages and what their allocators counted, or NULL. When they run at the same time,
+ *              the time of the first scan is the time of both.
+ * @return FOUND if the macros were expanded, NOT_FOUND otherwise.
+ */
+static int run_stages(MacroStage* stage, AssemblerManager* assemblerManager, SymbolsManager* symbolsManager, Registers* registers, Registers_2* registers_2, FileStats* stats) {
+	double start = stats_time();
+#ifdef USE_THREADS
+	LineQueue queue;
+	pthread_t thread;
+	char** line;
+#endif
+
+	/* Each stage takes its memory from its own allocator, so each is counted apart*/
+	if (stats != NULL) {
+		begin_counting(stats, InputPhase, stats->macro_allocator);
+		begin_counting(stats, FirstScanPhase, stats->scan_allocator);
+	}
+
+#ifdef USE_THREADS
+	init_line_queue(&queue);
+	stage->fileManager->queue = &queue;
+	stage->result = NOT_FOUND;
+	stage->errors = get_error_log();
+
+	if (pthread_create(&thread, NULL, run_macro_stage, stage) == 0) {
+		/* Scan the lines as they arrive, the labels are checked against the macros at the end*/
+		while ((line = line_queue_pop(&queue)) != NULL) {
+			first_scan_line(line, assemblerManager, symbolsManager, registers, registers_2);
+		}
+		pthread_join(thread, NULL);
+		stage->fileManager->queue = NULL;
+		checkSymbolsMacroNames(stage->macroManager, symbolsManager);
+		if (stats != NULL) {
+			stats->start[InputPhase] = stage->start;
+			stats->seconds[InputPhase] = stage->seconds;
+			stats->input_thread = FOUND;
+			stats->start[FirstScanPhase] = start;
+			stats->seconds[FirstScanPhase] = stats_time() - start;
+			end_counting(stats, InputPhase, stats->macro_allocator);
+			end_counting(stats, FirstScanPhase, stats->scan_allocator);
+		}
+		return stage->result;
+	}
+	/* No thread, run the stages one after the other*/
+	stage->fileManager->queue = NULL;
+#endif
+
+	stage->result = expand_stage(stage);
+	start = stats_time();
+	if (stage->result) {
+		first_scan(stage->macroManager, stage->fileManager, assemblerManager, symbolsManager, registers, registers_2);
+	}
+	if (stats != NULL) {
+		stats->start[InputPhase] = stage->start;
+		stats->seconds[InputPhase] = stage->seconds;
+		if (stage->result) {
+			stats->start[FirstScanPhase] = start;
+			stats->seconds[FirstScanPhase] = stats_time() - start;
+		}
+		end_counting(stats, InputPhase, stats->macro_allocator);
+		end_counting(stats, FirstScanPhase, stats->scan_allocator);
+	}
+	return stage->result;
+}
+
+/**
+ * run_first_pass -
+ * Expands the macros of the file_name.as file and performs the first scan of its lines.
+ *
+ * @param fileManager A pointer to the FileManager that receives the post-macro table.
+ * @param macroManager A pointer to the MacroManager of the file.
+ * @param file_name The base name of the input file, without its extension.
+ * @param assemblerManager A pointer to the AssemblerManager that keeps IC and DC.
+ * @param symbolsManager A pointer to the SymbolsManager that collects the symbols.
+ * @param stats Receives the time of the two stages, or NULL.
+ * @return FOUND if the macros were expanded, NOT_FOUND otherwise (the result of input_process).
+ */
+int run_first_pass(FileManager* fileManager, MacroManager* macroManager, char* file_name, AssemblerManager* assemblerManager, SymbolsManager* symbolsManager, Registers* registers, Registers_2* registers_2, FileStats* stats) {
+	MacroStage stage;
+	stage.fileManager = fileManager;
+	stage.macroManager = macroManager;
+	stage.file_name = file_name;
+	stage.source = NULL;
+	return run_stages(&stage, assemblerManager, symbolsManager, registers, registers_2, stats);
+}
+
+/**
+ * run_first_pass_source -
+ * Expands the macros of a source that is already open and performs the first scan of its lines.
+ *
+ * @param fileManager A pointer to the FileManager that receives the post-macro table.
+ * @param macroManager A pointer to the MacroManager of the file.
+ * @param source The opened source, left open.
+ * @param assemblerManager A pointer to the AssemblerManager that keeps IC and DC.
+ * @param symbolsManager A pointer to the SymbolsManager that collects the symbols.
+ * @param stats Receives the time of the two stages, or NULL.
+ * @return FOUND if the macros were expanded, NOT_FOUND otherwise.
+ */
+int run_first_pass_source(FileManager* fileManager, MacroManager* macroManager, SourceManager* source, AssemblerManager* assemblerManager, SymbolsManager* symbolsManager, Registers* registers, Registers_2* registers_2, FileStats* stats) {
+	MacroStage stage;
+	stage.fileManager = fileManager;
+	stage.macroManager = macroManager;
+	stage.file_name = NULL;
+	stage.source = source;
+	return run_stages(&stage, assemblerManager, symbolsManager, registers, registers_2, stats);
+}
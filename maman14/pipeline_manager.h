@@ -0,0 +1,33 @@
+#ifndef PIPELINE_MANAGER_H
+#define PIPELINE_MANAGER_H
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "constants.h"
+#include "error_manager.h"
+#include "queue_manager.h"
+#include "file_manager.h"
+#include "macro_manager.h"
+#include "assembler_manager.h"
+#include "symbols_manager.h"
+#include "actions.h"
+#include "operands.h"
+#include "stats_manager.h"
+
+/* Arguments of the thread that expands the macros*/
+typedef struct {
+	FileManager* fileManager;
+	MacroManager* macroManager;
+	char* file_name;
+	SourceManager* source;  /* The source to expand, or NULL to read the file_name.as file*/
+	int result;  /* What input_process returned*/
+	double start;    /* When the macros started to expand*/
+	double seconds;  /* How long the macros took to expand*/
+	ErrorLog* errors;  /* Where the errors of the file go, shared with the first scan*/
+} MacroStage;
+
+int run_first_pass(FileManager* fileManager, MacroManager* macroManager, char* file_name, AssemblerManager* assemblerManager, SymbolsManager* symbolsManager, Registers* registers, Registers_2* registers_2, FileStats* stats);
+int run_first_pass_source(FileManager* fileManager, MacroManager* macroManager, SourceManager* source, AssemblerManager* assemblerManager, SymbolsManager* symbolsManager, Registers* registers, Registers_2* registers_2, FileStats* stats);
+
+#endif /* PIPELINE_MANAGER_H*/
@@ -0,0 +1,85 @@
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "queue_manager.h"
+
+#ifdef USE_THREADS
+#include <sched.h>
+/* The index written by one thread is published to the other with release/acquire ordering*/
+#define QUEUE_LOAD(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define QUEUE_STORE(x, value) __atomic_store_n(&(x), (value), __ATOMIC_RELEASE)
+#define QUEUE_WAIT() sched_yield()
+#else
+#define QUEUE_LOAD(x) (x)
+#define QUEUE_STORE(x, value) ((x) = (value))
+#define QUEUE_WAIT()
+#endif
+
+/**
+ * init_line_queue -
+ * Initializes an empty queue.
+ *
+ * @param queue Pointer to the LineQueue structure to be initialized.
+ */
+void init_line_queue(LineQueue* queue) {
+	queue->head = 0;
+	queue->tail = 0;
+	queue->is_closed = NOT_FOUND;
+}
+
+/**
+ * line_queue_push -
+ * Adds a line at the end of the queue, waiting while the queue is full.
+ * Called only by the producer.
+ *
+ * @param queue Pointer to the LineQueue structure.
+ * @param line The NULL-terminated tokens of the line, they must stay valid until the consumer is done.
+ */
+void line_queue_push(LineQueue* queue, char** line) {
+	unsigned long tail = queue->tail;
+	while (tail - QUEUE_LOAD(queue->head) == LINE_QUEUE_SIZE) {
+		QUEUE_WAIT();
+	}
+	queue->items[tail & (LINE_QUEUE_SIZE - 1)] = line;
+	QUEUE_STORE(queue->tail, tail + 1);
+}
+
+/**
+ * line_queue_close -
+ * Marks that no more lines will be added.
+ * Called only by the producer.
+ *
+ * @param queue Pointer to the LineQueue structure.
+ */
+void line_queue_close(LineQueue* queue) {
+	QUEUE_STORE(queue->is_closed, FOUND);
+}
+
+/**
+ * line_queue_pop -
+ * Takes the first line of the queue, waiting while the queue is empty.
+ * Called only by the consumer.
+ *
+ * @param queue Pointer to the LineQueue structure.
+ * @return The tokens of the line, or NULL once the queue is closed and empty.
+ */
+char** line_queue_pop(LineQueue* queue) {
+	unsigned long head = queue->head;
+	for (;;) {
+		if (QUEUE_LOAD(queue->tail) != head) {
+			char** line = queue->items[head & (LINE_QUEUE_SIZE - 1)];
+			QUEUE_STORE(queue->head, head + 1);
+			return line;
+		}
+		/* Lines added before the queue was closed are still taken*/
+		if (QUEUE_LOAD(queue->is_closed)) {
+			if (QUEUE_LOAD(queue->tail) == head) {
+				return NULL;
+			}
+		}
+		else {
+			QUEUE_WAIT();
+		}
+	}
+}
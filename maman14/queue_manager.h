@@ -0,0 +1,30 @@
+#ifndef QUEUE_MANAGER_H
+#define QUEUE_MANAGER_H
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "constants.h"
+
+/* The macro stage and the first scan run on two threads with USE_THREADS, otherwise they run one after the other*/
+
+#define LINE_QUEUE_SIZE 4096 /* Must be a power of two*/
+#define CACHE_LINE_SIZE 64
+
+/* A bounded queue of post-macro lines with a single producer and a single consumer.
+ * Each side writes only its own index, so no lock is needed*/
+typedef struct {
+	char** items[LINE_QUEUE_SIZE]; /* NULL-terminated token arrays of the lines*/
+	unsigned long head;            /* Number of lines taken, written only by the consumer*/
+	char head_padding[CACHE_LINE_SIZE];
+	unsigned long tail;            /* Number of lines added, written only by the producer*/
+	char tail_padding[CACHE_LINE_SIZE];
+	int is_closed;                 /* FOUND once the producer will not add more lines*/
+} LineQueue;
+
+void init_line_queue(LineQueue* queue);
+void line_queue_push(LineQueue* queue, char** line);
+void line_queue_close(LineQueue* queue);
+char** line_queue_pop(LineQueue* queue);
+
+#endif /* QUEUE_MANAGER_H*/
@@ -9,9 +9,10 @@
 #include "constants.h"
 #include "error_manager.h"
 
+#define SOURCE_REGISTER_SHIFT 6 /* The source register is in bits 6-8*/
+#define DEST_REGISTER_SHIFT 3   /* The destination register is in bits 3-5*/
+#define NO_REGISTER -1          /* The operand of the word is not a register*/
 
-char* register_are();
-char* generate_single_register_line(int register_number, int is_source);
-
-char* generate_combined_register_line(int a_register_number, int b_register_number);
+Word register_are(void);
+int generate_register_line(Word* slot, int source_register_number, int dest_register_number);
 #endif /*REGISTER_BUILDER_H*/
@@ -0,0 +1,311 @@
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#define SOURCE_USE_MMAP
+#endif
+
+/* Lines are split 16 bytes at a time where SSE2 is available, byte by byte elsewhere*/
+#if defined(__SSE2__) && defined(__GNUC__)
+#define SOURCE_USE_SSE2
+#endif
+
+#include "source_manager.h"
+
+#ifdef SOURCE_USE_SSE2
+#include <emmintrin.h>
+#define SOURCE_BLOCK_SIZE 16
+#define SOURCE_BLOCK_MASK 0xFFFFu
+#endif
+
+#ifdef SOURCE_USE_MMAP
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/**
+ * read_source_file -
+ * Reads the whole file into a single heap buffer.
+ * Used when the platform has no memory mapping.
+ *
+ * @param source Pointer to the SourceManager whose data is filled.
+ * @param file_path The path of the file to read.
+ * @return FOUND if the file was read, NOT_FOUND otherwise.
+ */
+static int read_source_file(SourceManager* source, const char* file_path) {
+	char* data;
+	long length;
+	FILE* file = fopen(file_path, "rb");
+	if (file == NULL) {
+		return NOT_FOUND;
+	}
+
+	/* Find the size of the file*/
+	if (fseek(file, 0, SEEK_END) != 0 || (length = ftell(file)) < 0 || fseek(file, 0, SEEK_SET) != 0) {
+		fclose(file);
+		return NOT_FOUND;
+	}
+
+	data = (char*)malloc(length + 1);
+	if (data == NULL) {
+		log_error("read_source_file", 41, "source_manager.c", "Memory allocation failed");
+		fclose(file);
+		return NOT_FOUND;
+	}
+
+	if ((long)fread(data, 1, length, file) != length) {
+		free(data);
+		fclose(file);
+		return NOT_FOUND;
+	}
+	fclose(file);
+
+	source->data = data;
+	source->length = length;
+	source->storage = SourceHeap;
+	return FOUND;
+}
+
+/**
+ * open_source_manager -
+ * Opens a source file and prepares it for tokenizing.
+ * The file is memory mapped when possible, so tokenizing reads it in place without copying it.
+ *
+ * @param source Pointer to the SourceManager structure to be initialized.
+ * @param file_path The path of the file to open.
+ * @return FOUND if the file was opened, NOT_FOUND otherwise.
+ */
+int open_source_manager(SourceManager* source, const char* file_path) {
+	source->data = NULL;
+	source->length = 0;
+	source->position = 0;
+	source->storage = SourceHeap;
+	source->split_blocks = FOUND;
+	source->span_count = 0;
+	source->span_size = SPANS_INITIAL_SIZE;
+	source->spans = (TokenSpan*)malloc(source->span_size * sizeof(TokenSpan));
+	if (source->spans == NULL) {
+		log_error("open_source_manager", 81, "source_manager.c", "Memory allocation failed");
+		return NOT_FOUND;
+	}
+
+#ifdef SOURCE_USE_MMAP
+	{
+		struct stat file_stat;
+		int fd = open(file_path, O_RDONLY);
+		if (fd < 0) {
+			free(source->spans);
+			return NOT_FOUND;
+		}
+		if (fstat(fd, &file_stat) == 0 && S_ISREG(file_stat.st_mode)) {
+			if (file_stat.st_size == 0) {
+				/* Nothing to map, an empty file has no lines*/
+				close(fd);
+				source->storage = SourceMapped;
+				return FOUND;
+			}
+			else {
+				void* mapping = mmap(NULL, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (mapping != MAP_FAILED) {
+					close(fd);
+					source->data = (const char*)mapping;
+					source->length = (long)file_stat.st_size;
+					source->storage = SourceMapped;
+					return FOUND;
+				}
+			}
+		}
+		/* Not a regular file or mapping failed, fall back to reading it*/
+		close(fd);
+	}
+#endif
+
+	if (!read_source_file(source, file_path)) {
+		free(source->spans);
+		return NOT_FOUND;
+	}
+	return FOUND;
+}
+
+/**
+ * open_source_buffer -
+ * Prepares a source that is already in memory for tokenizing.
+ * The buffer is not copied, it must stay valid until the source is closed.
+ *
+ * @param source Pointer to the SourceManager structure to be initialized.
+ * @param data The characters of the source, they don't have to be null-terminated.
+ * @param length The number of characters in data.
+ * @return FOUND if the source is ready, NOT_FOUND otherwise.
+ */
+int open_source_buffer(SourceManager* source, const char* data, long length) {
+	source->data = length > 0 ? data : NULL;
+	source->length = length > 0 ? length : 0;
+	source->position = 0;
+	source->storage = SourceBorrowed;
+	source->split_blocks = FOUND;
+	source->span_count = 0;
+	source->span_size = SPANS_INITIAL_SIZE;
+	source->spans = (TokenSpan*)malloc(source->span_size * sizeof(TokenSpan));
+	if (source->spans == NULL) {
+		log_error("open_source_buffer", 149, "source_manager.c", "Memory allocation failed");
+		return NOT_FOUND;
+	}
+	return FOUND;
+}
+
+/**
+ * close_source_manager -
+ * Releases the source buffer and the tokenizer buffers.
+ *
+ * @param source Pointer to the SourceManager structure to be closed.
+ */
+void close_source_manager(SourceManager* source) {
+	if (source->data != NULL) {
+#ifdef SOURCE_USE_MMAP
+		if (source->storage == SourceMapped) {
+			munmap((void*)source->data, (size_t)source->length);
+		}
+#endif
+		if (source->storage == SourceHeap) {
+			free((void*)source->data);
+		}
+	}
+	free(source->spans);
+	source->data = NULL;
+	source->spans = NULL;
+}
+
+/**
+ * add_source_span -
+ * Records a token of the current line.
+ *
+ * @param source Pointer to the SourceManager structure.
+ * @param start Offset of the first character of the token.
+ * @param end Offset of the character after the token.
+ * @return FOUND if the token was recorded, NOT_FOUND if memory allocation failed.
+ */
+static int add_source_span(SourceManager* source, long start, long end) {
+	/* Grow the spans array if it is full*/
+	if (source->span_count == source->span_size) {
+		TokenSpan* new_spans = (TokenSpan*)realloc(source->spans, source->span_size * 2 * sizeof(TokenSpan));
+		if (new_spans == NULL) {
+			log_error("add_source_span", 168, "source_manager.c", "Memory allocation failed");
+			return NOT_FOUND;
+		}
+		source->spans = new_spans;
+		source->span_size *= 2;
+	}
+	source->spans[source->span_count].offset = start;
+	source->spans[source->span_count].length = (int)(end - start);
+	source->span_count++;
+	return FOUND;
+}
+
+/**
+ * split_source_line -
+ * Splits a line of the source buffer into tokens separated by spaces and commas.
+ * With SSE2, 16 bytes are classified with two compares and their separators are read as a bit mask,
+ * the tokens are the runs of clear bits. The bytes that are left are classified one by one, and so are
+ * all of them when source->split_blocks is NOT_FOUND.
+ *
+ * @param source Pointer to the SourceManager structure.
+ * @param position Offset of the first character of the line.
+ * @param line_end Offset of the character after the line.
+ * @return FOUND if the line was split into source->spans, NOT_FOUND if memory allocation failed.
+ */
+static int split_source_line(SourceManager* source, long position, long line_end) {
+	const char* data = source->data;
+	long start = -1; /* Offset of the token being read, -1 between tokens*/
+
+#ifdef SOURCE_USE_SSE2
+	const __m128i spaces = _mm_set1_epi8(' ');
+	const __m128i commas = _mm_set1_epi8(',');
+
+	/* A block may run past the end of the line but never past the end of the source*/
+	while (source->split_blocks && position < line_end && position + SOURCE_BLOCK_SIZE <= source->length) {
+		__m128i block = _mm_loadu_si128((const __m128i*)(data + position));
+		unsigned int separators = (unsigned int)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, spaces), _mm_cmpeq_epi8(block, commas)));
+		int block_length = line_end - position < SOURCE_BLOCK_SIZE ? (int)(line_end - position) : SOURCE_BLOCK_SIZE;
+		int i = 0;
+
+		/* The bytes after the end of the line separate like spaces*/
+		separators = (separators | (SOURCE_BLOCK_MASK << block_length)) & SOURCE_BLOCK_MASK;
+
+		while (i < block_length) {
+			unsigned int rest;
+			if (start < 0) {
+				/* The next token starts at the next clear bit*/
+				rest = ~separators & (SOURCE_BLOCK_MASK << i) & SOURCE_BLOCK_MASK;
+				if (rest == 0) {
+					break;
+				}
+				i = __builtin_ctz(rest);
+				start = position + i;
+			}
+			else {
+				/* The token ends at the next set bit*/
+				rest = separators & (SOURCE_BLOCK_MASK << i);
+				if (rest == 0) {
+					break;
+				}
+				i = __builtin_ctz(rest);
+				if (!add_source_span(source, start, position + i)) {
+					return NOT_FOUND;
+				}
+				start = -1;
+			}
+		}
+		position += block_length;
+	}
+#endif
+
+	/* The rest of the line, one byte at a time*/
+	for (; position < line_end; position++) {
+		int is_separator = data[position] == ' ' || data[position] == ',';
+		if (start < 0 && !is_separator) {
+			start = position;
+		}
+		else if (start >= 0 && is_separator) {
+			if (!add_source_span(source, start, position)) {
+				return NOT_FOUND;
+			}
+			start = -1;
+		}
+	}
+	if (start >= 0) {
+		return add_source_span(source, start, line_end);
+	}
+	return FOUND;
+}
+
+/**
+ * next_source_line -
+ * Tokenizes the next line of the source buffer.
+ * Tokens are separated by spaces and commas and are recorded as spans into the source buffer,
+ * so no memory is allocated per token.
+ *
+ * @param source Pointer to the SourceManager structure.
+ * @return FOUND if a line was read into source->spans, NOT_FOUND when the end of the source was reached.
+ */
+int next_source_line(SourceManager* source) {
+	const char* data = source->data;
+	long position = source->position;
+	const char* newline;
+	long line_end;
+
+	if (position >= source->length) {
+		return NOT_FOUND;
+	}
+
+	/* Find the end of the line, memchr compares many bytes at a time*/
+	newline = (const char*)memchr(data + position, '\n', (size_t)(source->length - position));
+	line_end = newline != NULL ? (long)(newline - data) : source->length;
+	source->position = line_end + 1;
+
+	/* A carriage return before the newline is not part of the line*/
+	if (line_end > position && data[line_end - 1] == '\r') line_end--;
+
+	source->span_count = 0;
+	return split_source_line(source, position, line_end);
+}
@@ -0,0 +1,42 @@
+#ifndef SOURCE_MANAGER_H
+#define SOURCE_MANAGER_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "constants.h"
+#include "error_manager.h"
+
+#define SPANS_INITIAL_SIZE 16
+
+/* A token is described by its place in the source buffer, it is never copied by the tokenizer*/
+typedef struct {
+	long offset; /* Offset of the first character of the token in the source buffer*/
+	int length;  /* Number of characters in the token*/
+} TokenSpan;
+
+/* Who owns the source buffer*/
+typedef enum SourceStorage {
+	SourceHeap,     /* Read into the heap, freed on close*/
+	SourceMapped,   /* A memory mapping of the file, unmapped on close*/
+	SourceBorrowed  /* The caller's buffer, left untouched on close*/
+} SourceStorage;
+
+typedef struct {
+	const char* data; /* Contents of the source file (memory mapped when the platform allows it)*/
+	long length;      /* Number of characters in data*/
+	long position;    /* Offset of the next line to tokenize*/
+	SourceStorage storage;
+	int split_blocks; /* FOUND to split lines 16 bytes at a time where SSE2 is available, NOT_FOUND for byte by byte*/
+	TokenSpan* spans; /* Token spans of the current line, reused from line to line*/
+	int span_count;
+	int span_size;
+} SourceManager;
+
+int open_source_manager(SourceManager* source, const char* file_path);
+int open_source_buffer(SourceManager* source, const char* data, long length);
+void close_source_manager(SourceManager* source);
+int next_source_line(SourceManager* source);
+
+#endif /* SOURCE_MANAGER_H*/
@@ -0,0 +1,267 @@
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200112L
+#define STATS_USE_POSIX_CLOCK
+#endif
+
+#include "stats_manager.h"
+
+#include <time.h>
+
+static const char* phase_names[STATS_PHASE_COUNT] = {
+	"input_process", "printPostMacroToFile", "first_scan",
+	"updateDataItemsLocation", "second_scan", "printObjToFile",
+	"printReferenceSymbolsToFile"
+};
+
+/**
+ * stats_time -
+ * Gives a wall clock time to measure phases with.
+ *
+ * @return The time in seconds, from an arbitrary start.
+ */
+double stats_time(void) {
+#ifdef STATS_USE_POSIX_CLOCK
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec / 1e9;
+#else
+	/* Processor time, the best C90 has*/
+	return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+/**
+ * init_file_stats -
+ * Initializes the stats of a file to zero.
+ *
+ * @param stats Pointer to the FileStats to initialize.
+ */
+void init_file_stats(FileStats* stats) {
+	int phase;
+	for (phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+		stats->start[phase] = -1;
+		stats->seconds[phase] = 0;
+	}
+	stats->input_thread = NOT_FOUND;
+	stats->lines = 0;
+	stats->tokens = 0;
+	stats->macro_expansions = 0;
+	stats->symbols = 0;
+	stats->fixups = 0;
+	stats->words = 0;
+	stats->allocations = 0;
+	stats->peak_bytes = 0;
+	stats->counted = NOT_FOUND;
+	for (phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+		stats->phase_allocations[phase] = 0;
+		stats->phase_bytes[phase] = 0;
+	}
+	stats->macro_allocator = NULL;
+	stats->scan_allocator = NULL;
+}
+
+/**
+ * add_counts -
+ * Adds what an allocator counted so far, if it counts.
+ *
+ * @param allocator The allocator, or NULL.
+ * @param allocations Receives the allocations it counted.
+ * @param bytes Receives the bytes it counted.
+ */
+static void add_counts(const Allocator* allocator, unsigned long* allocations, size_t* bytes) {
+	if (allocator != NULL && allocator->kind == CountingAllocator) {
+		*allocations += allocator->counts.allocations;
+		*bytes += allocator->counts.bytes;
+	}
+}
+
+/**
+ * begin_counting -
+ * Records where the counts of an allocator are when a phase starts.
+ * Until the phase ends, its counts hold where they started.
+ *
+ * @param stats The stats of the file.
+ * @param phase The phase that starts.
+ * @param allocator The allocator the phase takes its memory from, or NULL.
+ */
+void begin_counting(FileStats* stats, StatsPhase phase, const Allocator* allocator) {
+	stats->phase_allocations[phase] = 0;
+	stats->phase_bytes[phase] = 0;
+	add_counts(allocator, &stats->phase_allocations[phase], &stats->phase_bytes[phase]);
+}
+
+/**
+ * end_counting -
+ * Records what an allocator counted during a phase, started by begin_counting with the same allocator.
+ *
+ * @param stats The stats of the file.
+ * @param phase The phase that ends.
+ * @param allocator The allocator the phase takes its memory from, or NULL.
+ */
+void end_counting(FileStats* stats, StatsPhase phase, const Allocator* allocator) {
+	unsigned long allocations = 0;
+	size_t bytes = 0;
+	add_counts(allocator, &allocations, &bytes);
+	stats->phase_allocations[phase] = allocations - stats->phase_allocations[phase];
+	stats->phase_bytes[phase] = bytes - stats->phase_bytes[phase];
+}
+
+/**
+ * begin_phase -
+ * Records that a phase starts now.
+ *
+ * @param stats The stats of the file.
+ * @param phase The phase that starts.
+ */
+void begin_phase(FileStats* stats, StatsPhase phase) {
+	begin_counting(stats, phase, stats->macro_allocator);
+	add_counts(stats->scan_allocator, &stats->phase_allocations[phase], &stats->phase_bytes[phase]);
+	stats->start[phase] = stats_time();
+}
+
+/**
+ * end_phase -
+ * Records that a phase, started by begin_phase, ends now.
+ *
+ * @param stats The stats of the file.
+ * @param phase The phase that ends.
+ */
+void end_phase(FileStats* stats, StatsPhase phase) {
+	unsigned long allocations = 0;
+	size_t bytes = 0;
+
+	stats->seconds[phase] = stats_time() - stats->start[phase];
+	add_counts(stats->macro_allocator, &allocations, &bytes);
+	add_counts(stats->scan_allocator, &allocations, &bytes);
+	stats->phase_allocations[phase] = allocations - stats->phase_allocations[phase];
+	stats->phase_bytes[phase] = bytes - stats->phase_bytes[phase];
+}
+
+/**
+ * count_file_allocators -
+ * Records the totals of the file's allocators once the file is assembled, before they are released.
+ * A counting allocator gives its own counts, a bump allocator what its arena took from the system.
+ * The allocators are not referenced anymore afterwards.
+ *
+ * @param stats The stats of the file, with the file's allocators.
+ */
+void count_file_allocators(FileStats* stats) {
+	const Allocator* allocators[2];
+	int i;
+
+	allocators[0] = stats->macro_allocator;
+	allocators[1] = stats->scan_allocator;
+	for (i = 0; i < 2; i++) {
+		if (allocators[i] == NULL) {
+			continue;
+		}
+		if (allocators[i]->kind == CountingAllocator) {
+			stats->counted = FOUND;
+			stats->allocations += allocators[i]->counts.allocations;
+			stats->peak_bytes += allocators[i]->counts.peak_bytes;
+		}
+		else if (allocators[i]->kind == BumpAllocator) {
+			stats->allocations += allocators[i]->arena->allocation_count;
+			stats->peak_bytes += allocators[i]->arena->total_size;
+		}
+	}
+	stats->macro_allocator = NULL;
+	stats->scan_allocator = NULL;
+}
+
+/**
+ * phase_name -
+ * Gives the name a phase is reported under.
+ *
+ * @param phase The phase.
+ * @return The name of the phase.
+ */
+const char* phase_name(StatsPhase phase) {
+	return phase_names[phase];
+}
+
+/**
+ * print_stats_text -
+ * Prints the stats of a file for a person to read.
+ *
+ * @param file The file to print to.
+ * @param file_name The name of the assembled file.
+ * @param stats The stats of the file.
+ */
+void print_stats_text(FILE* file, const char* file_name, const FileStats* stats) {
+	int phase;
+	fprintf(file, "stats for %s\n", file_name);
+	for (phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+		fprintf(file, "  %-28s %12.6f s", phase_names[phase], stats->seconds[phase]);
+		if (stats->counted) {
+			fprintf(file, " %10lu allocations %12lu bytes", stats->phase_allocations[phase], (unsigned long)stats->phase_bytes[phase]);
+		}
+		fputc('\n', file);
+	}
+	fprintf(file, "  %-28s %12ld\n", "lines", stats->lines);
+	fprintf(file, "  %-28s %12ld\n", "tokens", stats->tokens);
+	fprintf(file, "  %-28s %12ld\n", "macro_expansions", stats->macro_expansions);
+	fprintf(file, "  %-28s %12ld\n", "symbols", stats->symbols);
+	fprintf(file, "  %-28s %12ld\n", "fixups", stats->fixups);
+	fprintf(file, "  %-28s %12ld\n", "words", stats->words);
+	fprintf(file, "  %-28s %12lu\n", "allocations", stats->allocations);
+	fprintf(file, "  %-28s %12lu\n", "peak_bytes", (unsigned long)stats->peak_bytes);
+}
+
+/**
+ * print_json_string -
+ * Prints a string as a JSON string, with its quotes.
+ *
+ * @param file The file to print to.
+ * @param text The string to print.
+ */
+void print_json_string(FILE* file, const char* text) {
+	fputc('"', file);
+	for (; *text != '\0'; text++) {
+		unsigned char c = (unsigned char)*text;
+		if (c == '"' || c == '\\') {
+			fputc('\\', file);
+			fputc(c, file);
+		}
+		else if (c < 0x20) {
+			fprintf(file, "\\u%04x", c);
+		}
+		else {
+			fputc(c, file);
+		}
+	}
+	fputc('"', file);
+}
+
+/**
+ * print_stats_json -
+ * Prints the stats of a file as one JSON object, without a newline after it.
+ *
+ * @param file The file to print to.
+ * @param file_name The name of the assembled file.
+ * @param stats The stats of the file.
+ */
+void print_stats_json(FILE* file, const char* file_name, const FileStats* stats) {
+	int phase;
+	fprintf(file, "{\"file\": ");
+	print_json_string(file, file_name);
+	fprintf(file, ", \"seconds\": {");
+	for (phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+		fprintf(file, "%s\"%s\": %.6f", phase > 0 ? ", " : "", phase_names[phase], stats->seconds[phase]);
+	}
+	fprintf(file, "}, \"lines\": %ld, \"tokens\": %ld, \"macro_expansions\": %ld, \"symbols\": %ld, \"fixups\": %ld, \"words\": %ld",
+		stats->lines, stats->tokens, stats->macro_expansions, stats->symbols, stats->fixups, stats->words);
+	fprintf(file, ", \"allocations\": %lu, \"peak_bytes\": %lu", stats->allocations, (unsigned long)stats->peak_bytes);
+	if (stats->counted) {
+		fprintf(file, ", \"phase_allocations\": {");
+		for (phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+			fprintf(file, "%s\"%s\": %lu", phase > 0 ? ", " : "", phase_names[phase], stats->phase_allocations[phase]);
+		}
+		fprintf(file, "}, \"phase_bytes\": {");
+		for (phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+			fprintf(file, "%s\"%s\": %lu", phase > 0 ? ", " : "", phase_names[phase], (unsigned long)stats->phase_bytes[phase]);
+		}
+		fputc('}', file);
+	}
+	fputc('}', file);
+}
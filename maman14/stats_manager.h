@@ -0,0 +1,61 @@
+#ifndef STATS_MANAGER_H
+#define STATS_MANAGER_H
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "constants.h"
+#include "memory_manager.h"
+
+/* The phases of assembling a file, in the order they run*/
+typedef enum StatsPhase {
+	InputPhase,         /* input_process: tokenizing and macro expansion*/
+	PostMacroPhase,     /* printPostMacroToFile*/
+	FirstScanPhase,     /* first_scan, it overlaps input_process when the pipeline runs on two threads*/
+	DataLocationPhase,  /* updateLocationDataSymbols and updateDataItemsLocation*/
+	SecondScanPhase,    /* second_scan*/
+	ObjectPhase,        /* printObjToFile*/
+	ReferencesPhase,    /* printReferenceSymbolsToFile*/
+	STATS_PHASE_COUNT
+} StatsPhase;
+
+/* How --stats are printed*/
+typedef enum StatsFormat {
+	NoStats,
+	TextStats,
+	JsonStats
+} StatsFormat;
+
+/* What assembling one file took, and when*/
+typedef struct {
+	double start[STATS_PHASE_COUNT];    /* stats_time when each phase started, negative if it did not run*/
+	double seconds[STATS_PHASE_COUNT];  /* Wall time of each phase*/
+	int input_thread;       /* FOUND if input_process ran on a thread of its own*/
+	long lines;             /* Source lines*/
+	long tokens;            /* Source tokens*/
+	long macro_expansions;  /* Macro invocations expanded*/
+	long symbols;           /* Symbols defined*/
+	long fixups;            /* Label operands resolved by the second scan*/
+	long words;             /* Machine words emitted*/
+	unsigned long allocations; /* Allocations from the file's allocators, 0 if they do not count them*/
+	size_t peak_bytes;      /* Most bytes the file's allocators held, 0 if they do not count them*/
+	int counted;            /* FOUND if the allocators counted, then each phase has its allocations*/
+	unsigned long phase_allocations[STATS_PHASE_COUNT]; /* Allocations and resizes during each phase*/
+	size_t phase_bytes[STATS_PHASE_COUNT];              /* Bytes allocated during each phase*/
+	const Allocator* macro_allocator; /* The allocators of the file while it is assembled, or NULL*/
+	const Allocator* scan_allocator;
+} FileStats;
+
+double stats_time(void);
+void init_file_stats(FileStats* stats);
+void begin_phase(FileStats* stats, StatsPhase phase);
+void end_phase(FileStats* stats, StatsPhase phase);
+void begin_counting(FileStats* stats, StatsPhase phase, const Allocator* allocator);
+void end_counting(FileStats* stats, StatsPhase phase, const Allocator* allocator);
+void count_file_allocators(FileStats* stats);
+const char* phase_name(StatsPhase phase);
+void print_stats_text(FILE* file, const char* file_name, const FileStats* stats);
+void print_stats_json(FILE* file, const char* file_name, const FileStats* stats);
+void print_json_string(FILE* file, const char* text);
+
+#endif /* STATS_MANAGER_H*/
@@ -9,22 +9,26 @@
  * and reference symbols. It sets initial sizes and allocates memory accordingly.
  * If any memory allocation fails, the function logs an error and returns.
  *
+ * @param allocator The allocator that owns the SymbolsManager's memory.
  * @return SymbolsManager* A pointer to the newly created and initialized SymbolsManager instance.
  */
-SymbolsManager* createSymbolsManager() {
-	SymbolsManager* manager = (SymbolsManager*)malloc(sizeof(SymbolsManager));
+SymbolsManager* createSymbolsManager(Allocator* allocator) {
+	SymbolsManager* manager = (SymbolsManager*)allocate_memory(allocator, sizeof(SymbolsManager));
 	if (manager == NULL) {
 		log_error("createSymbolsManager", 17, "symbols_manager.c", "Failed to create SymbolsManager");
 		return NULL;
 	}
+	manager->allocator = allocator;
+	init_atom_table(&manager->atoms, allocator);
+	manager->atom_index = NULL;
+	manager->atom_size = 0;
 
 	/* Initialize Symbols array*/
 	manager->has_symbols_errors = NOT_FOUND;
-	manager->array = (Symbols*)malloc(5 * sizeof(Symbols)); /* Initial size of 5*/
+	manager->array = (Symbols*)allocate_memory(allocator, 5 * sizeof(Symbols)); /* Initial size of 5*/
 	/*Failed to allocate memory for Symbols array*/
 	if (manager->array == NULL) {
 		log_error("createSymbolsManager", 26, "symbols_manager.c", "Failed to allocate memory for Symbols array array");
-		free(manager);
 		return NULL;
 	}
 	/*Memory allocation succeeded*/
@@ -32,44 +36,31 @@ SymbolsManager* createSymbolsManager() {
 	manager->size = 5;
 
 	/* Initialize ext array*/
-	manager->ext = (char**)malloc(5 * sizeof(char*)); /* Initial size of 5*/
+	manager->ext = (const char**)allocate_memory(allocator, 5 * sizeof(char*)); /* Initial size of 5*/
 
 	/*Failed to allocate memory for ext array*/
 	if (manager->ext == NULL) {
 		log_error("createSymbolsManager", 39, "symbols_manager.c", "Failed to allocate memory for ext array");
-
-		free(manager->array);
-		free(manager);
 		return NULL;
 	}
 	manager->ext_used = 0;
 	manager->ext_size = 5;
 
 	/* Initialize ent array*/
-	manager->ent = (char**)malloc(5 * sizeof(char*)); /* Initial size of 5*/
+	manager->ent = (const char**)allocate_memory(allocator, 5 * sizeof(char*)); /* Initial size of 5*/
 	/*Failed to allocate memory for ent array*/
 	if (manager->ent == NULL) {
 		log_error("createSymbolsManager", 52, "symbols_manager.c", "Failed to allocate memory for ent array");
-
-		manager->has_symbols_errors = FOUND;
-		free(manager->ext);
-		free(manager->array);
-		free(manager);
 		return NULL;
 	}
 	manager->ent_used = 0;
 	manager->ent_size = 5;
 
 	/* Initialize ref_symbols array*/
-	manager->ref_symbols = (ReferenceSymbol*)malloc(5 * sizeof(ReferenceSymbol)); /* Initial size of 5*/
+	manager->ref_symbols = (ReferenceSymbol*)allocate_memory(allocator, 5 * sizeof(ReferenceSymbol)); /* Initial size of 5*/
 	/*Failed to allocate memory for ref_symbols array*/
 	if (manager->ref_symbols == NULL) {
 		log_error("createSymbolsManager", 67, "symbols_manager.c", "Failed to allocate memory for ref_symbols array");
-
-		free(manager->ent);
-		free(manager->ext);
-		free(manager->array);
-		free(manager);
 		return NULL;
 	}
 	manager->ref_used = 0;
@@ -78,28 +69,60 @@ SymbolsManager* createSymbolsManager() {
 	return manager;
 }
 
+/**
+ * internSymbolName -
+ * Interns a name in the SymbolsManager, making room for the atom in the index.
+ *
+ * @param manager The SymbolsManager instance.
+ * @param name The characters of the name, they do not have to be null-terminated.
+ * @param length The number of characters in the name.
+ * @return The atom of the name, or NO_ATOM if memory allocation failed.
+ */
+Atom internSymbolName(SymbolsManager* manager, const char* name, size_t length) {
+	Atom atom = intern_atom(&manager->atoms, name, length);
+	if (atom != NO_ATOM && atom >= manager->atom_size) {
+		int i;
+		int new_size = manager->atom_size ? manager->atom_size * 2 : ATOMS_INITIAL_SIZE;
+		SymbolIndex* new_index = (SymbolIndex*)resize_memory(manager->allocator, manager->atom_index, new_size * sizeof(SymbolIndex));
+		if (new_index == NULL) {
+			log_error("internSymbolName", 88, "symbols_manager.c", "Memory allocation failed");
+			manager->has_symbols_errors = FOUND;
+			return NO_ATOM;
+		}
+		/* A new atom is not a symbol and was not declared as a reference yet*/
+		for (i = manager->atom_size; i < new_size; i++) {
+			new_index[i].symbol = NOT_FOUND_SYMBOL;
+			new_index[i].references = 0;
+		}
+		manager->atom_index = new_index;
+		manager->atom_size = new_size;
+	}
+	else if (atom == NO_ATOM) {
+		manager->has_symbols_errors = FOUND;
+	}
+	return atom;
+}
+
 /**
  * addSymbol -
  * Adds a new symbol to the SymbolsManager if all validation checks pass.
+ * Symbols that are macro names are found once the file is scanned, by checkSymbolsMacroNames.
  *
- * @param macroManager The MacroManager instance used to check if the symbol is a macro name.
  * @param manager The SymbolsManager instance where the symbol will be added.
  * @param symbol_name The name of the symbol to add.
  * @param symbol_location The location of the symbol.
  * @param is_data Flag indicating if the symbol is data.
- * @param actions Action instance used for additional symbol name validation.
  */
-void addSymbol(MacroManager* macroManager, SymbolsManager* manager, char* symbol_name, int symbol_location, int is_data, Action* actions, Registers* registers) {
-	if (is_symbol_exists(manager, symbol_name)) {
-		log_error("addSymbol", 94, "symbols_manager.c", "symbol already exists");
-		manager->has_symbols_errors = FOUND;
+void addSymbol(SymbolsManager* manager, const char* symbol_name, int symbol_location, int is_data, Registers* registers) {
+	Atom atom = internSymbolName(manager, symbol_name, strlen(symbol_name));
+	if (atom == NO_ATOM) {
+		return;
 	}
-	else if (is_macro_name(macroManager, symbol_name)) {
-		label_error("addSymbol", 98, "symbols_manager.c", "symbol cannot be a macro name", symbol_name);
+	if (manager->atom_index[atom].symbol != NOT_FOUND_SYMBOL) {
+		log_error("addSymbol", 94, "symbols_manager.c", "symbol already exists");
 		manager->has_symbols_errors = FOUND;
-
 	}
-	else if (!is_valid_symbol_name(manager, symbol_name, actions, registers)) {
+	else if (!is_valid_symbol_name(symbol_name, registers)) {
 		label_error("addSymbol", 103, "symbols_manager.c", "symbol isnt valid", symbol_name);
 		manager->has_symbols_errors = FOUND;
 
@@ -112,7 +135,7 @@ void addSymbol(MacroManager* macroManager, SymbolsManager* manager, char* symbol
 		if (manager->used == manager->size) {
 			Symbols* new_array;
 			manager->size *= 2;
-			new_array = (Symbols*)realloc(manager->array, manager->size * sizeof(Symbols));
+			new_array = (Symbols*)resize_memory(manager->allocator, manager->array, manager->size * sizeof(Symbols));
 			if (new_array == NULL) {
 				log_error("addSymbol", 117, "symbols_manager.c", "Failed to reallocate memory for Symbols array");
 				manager->has_symbols_errors = FOUND;
@@ -120,14 +143,8 @@ void addSymbol(MacroManager* macroManager, SymbolsManager* manager, char* symbol
 			}
 			manager->array = new_array;
 		}
-		manager->array[manager->used].symbol_name = duplicate_string(symbol_name); /* Make a copy of the string*/
-		if (manager->array[manager->used].symbol_name == NULL) {
-			log_error("addSymbol", 125, "symbols_manager.c", "Failed to duplicate");
-			manager->has_symbols_errors = FOUND;
-			free(manager->array);
-			free(manager);
-			return;
-		}
+		manager->array[manager->used].symbol_name = atom_name(&manager->atoms, atom); /* The one copy of the name*/
+		manager->atom_index[atom].symbol = manager->used;
 		manager->array[manager->used].symbol_location = symbol_location;
 		manager->array[manager->used].is_data = is_data;
 		manager->used++;
@@ -135,6 +152,24 @@ void addSymbol(MacroManager* macroManager, SymbolsManager* manager, char* symbol
 
 }
 
+/**
+ * checkSymbolsMacroNames -
+ * Checks that no symbol is a macro name.
+ * Called once the first scan is done, the symbols are added before all the macros are known.
+ *
+ * @param macroManager The MacroManager instance holding all the macros of the file.
+ * @param manager The SymbolsManager instance whose symbols are checked.
+ */
+void checkSymbolsMacroNames(MacroManager* macroManager, SymbolsManager* manager) {
+	int i;
+	for (i = 0; i < manager->used; i++) {
+		if (is_macro_name(macroManager, manager->array[i].symbol_name)) {
+			label_error("checkSymbolsMacroNames", 137, "symbols_manager.c", "symbol cannot be a macro name", manager->array[i].symbol_name);
+			manager->has_symbols_errors = FOUND;
+		}
+	}
+}
+
 /**
  * printSymbols -
  * Prints the symbols managed by the SymbolsManager in a formatted table.
@@ -163,37 +198,33 @@ void printSymbols(const SymbolsManager* manager) {
  * @return The location of the symbol if found, or -1 if the symbol is not found.
  */
 int getSymbolLocation(const SymbolsManager* manager, const char* symbol_name) {
-	int i;
-	for (i = 0; i < manager->used; i++) {
-		if (strcmp(manager->array[i].symbol_name, symbol_name) == 0) {
-			return manager->array[i].symbol_location;
-		}
+	Atom atom = find_atom(&manager->atoms, symbol_name, strlen(symbol_name));
+	if (atom != NO_ATOM && manager->atom_index[atom].symbol != NOT_FOUND_SYMBOL) {
+		return manager->array[manager->atom_index[atom].symbol].symbol_location;
 	}
 	log_error("getSymbolLocation", 172, "symbols_manager.c", "symbol not found, valid symbold are 'r0-r7'");
 	return NOT_FOUND_SYMBOL; /* Indicate that the symbol was not found*/
 }
 
 /**
- * destroySymbolsManager -
- * Frees all allocated memory associated with the SymbolsManager.
+ * resolveSymbol -
+ * Finds what a label operand refers to with one access to the index.
  *
- * @param manager The SymbolsManager instance to destroy.
+ * @param manager The SymbolsManager instance.
+ * @param atom The atom of the label, interned when its line was built.
+ * @param location Set to the location of the symbol when the name is a symbol.
+ * @return ExternalSymbol if the name was declared by .extern, LocalSymbol if it is a symbol of the file,
+ *         UnknownSymbol otherwise.
  */
-void destroySymbolsManager(SymbolsManager* manager) {
-	int i;
-	for (i = 0; i < manager->used; i++) {
-		free(manager->array[i].symbol_name); /* Free the copied strings*/
+SymbolKind resolveSymbol(const SymbolsManager* manager, Atom atom, int* location) {
+	if (manager->atom_index[atom].references & REFERENCE_EXTERN) {
+		return ExternalSymbol;
 	}
-	for (i = 0; i < manager->ext_used; i++) {
-		free(manager->ext[i]); /* Free the ext strings*/
-	}
-	for (i = 0; i < manager->ent_used; i++) {
-		free(manager->ent[i]); /* Free the ent strings*/
+	if (manager->atom_index[atom].symbol != NOT_FOUND_SYMBOL) {
+		*location = manager->array[manager->atom_index[atom].symbol].symbol_location;
+		return LocalSymbol;
 	}
-	free(manager->array);
-	free(manager->ext);
-	free(manager->ent);
-	free(manager);
+	return UnknownSymbol;
 }
 
 /**
@@ -206,79 +237,61 @@ void destroySymbolsManager(SymbolsManager* manager) {
  *
  */
 void addExtEnt(SymbolsManager* manager, const char* value, int is_ext) {
+	Atom atom = internSymbolName(manager, value, strlen(value));
+	if (atom == NO_ATOM) {
+		return;
+	}
 	if (is_ext) {
 		/* Handle addition of an external symbol*/
-		if (isRefExtSymbolExists(manager, value)) {
+		if (manager->atom_index[atom].references & REFERENCE_EXTERN) {
 			/*symbol already exists*/
 			log_error("addExtEnt", 213, "symbols_manager.c", "symbol already exists");
 			manager->has_symbols_errors = FOUND;
 		}
 		else {
 			if (manager->ext_used == manager->ext_size) {
-				char** new_ext;
+				const char** new_ext;
 				manager->ext_size *= 2;
-				new_ext = (char**)realloc(manager->ext, manager->ext_size * sizeof(char*));
+				new_ext = (const char**)resize_memory(manager->allocator, (void*)manager->ext, manager->ext_size * sizeof(char*));
 				if (new_ext == NULL) {
 					log_error("addExtEnt", 222, "symbols_manager.c", "Failed to reallocate memory for ext array");
-					free(manager->ext);
-					free(manager->array);
-					free(manager->ent);
-					free(manager);
+					manager->has_symbols_errors = FOUND;
 					return;
 				}
 				manager->ext = new_ext;
 			}
-			/* Duplicate the symbol value and add it to the external symbols array*/
-			manager->ext[manager->ext_used] = duplicate_string(value); /* Make a copy of the string*/
-			if (manager->ext[manager->ext_used] == NULL) {
-				log_error("addExtEnt", 234, "symbols_manager.c", "Failed to duplicate value");
-
-				free(manager->ext);
-				free(manager->array);
-				free(manager->ent);
-				free(manager);
-				return;
-			}
+			/* Add the interned symbol to the external symbols array*/
+			manager->ext[manager->ext_used] = atom_name(&manager->atoms, atom);
+			manager->atom_index[atom].references |= REFERENCE_EXTERN;
 			manager->ext_used++;
 		}
 
 	}
 	else {
 		/* Handle addition of an entry symbol*/
-		if (isRefEntSymbolExists(manager, value)) {
+		if (manager->atom_index[atom].references & REFERENCE_ENTRY) {
 			/*symbol already exists*/
 			log_error("addExtEnt", 250, "symbols_manager.c", "symbol already exists");
 			manager->has_symbols_errors = FOUND;
 		}
 		else {
 			if (manager->ent_used == manager->ent_size) {
-				char** new_ent;
+				const char** new_ent;
 
 				/* Double the size of the entry symbols array*/
 				manager->ent_size *= 2;
-				new_ent = (char**)realloc(manager->ent, manager->ent_size * sizeof(char*));
+				new_ent = (const char**)resize_memory(manager->allocator, (void*)manager->ent, manager->ent_size * sizeof(char*));
 				if (new_ent == NULL) {
 					log_error("addExtEnt", 261, "symbols_manager.c", "Failed to reallocate memory for ent array");
-
-					free(manager->ent);
-					free(manager->array);
-					free(manager->ext);
-					free(manager);
+					manager->has_symbols_errors = FOUND;
 					return;
 				}
 				manager->ent = new_ent;
 			}
 
-			/* Duplicate the symbol value and add it to the entry symbols array*/
-			manager->ent[manager->ent_used] = duplicate_string(value); /* Make a copy of the string*/
-			if (manager->ent[manager->ent_used] == NULL) {
-				log_error("addExtEnt", 275, "symbols_manager.c", "Failed to duplicate value");
-				free(manager->ent);
-				free(manager->array);
-				free(manager->ext);
-				free(manager);
-				return;
-			}
+			/* Add the interned symbol to the entry symbols array*/
+			manager->ent[manager->ent_used] = atom_name(&manager->atoms, atom);
+			manager->atom_index[atom].references |= REFERENCE_ENTRY;
 			manager->ent_used++;
 		}
 	}
@@ -288,39 +301,28 @@ void addExtEnt(SymbolsManager* manager, const char* value, int is_ext) {
  * updateSymbolsTable -
  * Updates the symbols table based on the provided line of assembly code.
  *
- * @param macroManager Pointer to the MacroManager structure, used to check if the symbol is a macro name.
  * @param symbolsManager Pointer to the SymbolsManager structure, used to manage symbols and symbol lists.
- * @param line Array of strings representing a line of assembly code, where line[0] is the directive or symbol
- *             name and line[1] is the associated value or type.
+ * @param parsed The line of assembly code, as built by build_line.
  * @param location The current location in the assembly code, used to determine the symbol's location.
- * @param actions Pointer to the Action structure, used to verify the validity of actions associated with symbols.
  *
  * @return None
  */
-void updateSymbolsTable(MacroManager* macroManager, SymbolsManager* symbolsManager, char** line, int location, Action* actions, Registers* registers) {
-	if (strcmp(line[0], ".extern") == 0) {
-		addExtEnt(symbolsManager, line[1], FOUND);
+void updateSymbolsTable(SymbolsManager* symbolsManager, const ParsedLine* parsed, int location, Registers* registers) {
+	if (parsed->type == ExternLine) {
+		addExtEnt(symbolsManager, parsed->arguments[0], FOUND);
 	}
-	else if (strcmp(line[0], ".entry") == 0) {
-		addExtEnt(symbolsManager, line[1], NOT_FOUND);
+	else if (parsed->type == EntryLine) {
+		addExtEnt(symbolsManager, parsed->arguments[0], NOT_FOUND);
 	}
-	else {
-		if (isSymbolPattern(line[0])) {
-			char* symbol_name = strtrimlast(line[0]);
-			if (symbol_name == NULL) {
-				log_error("updateSymbolsTable", 311, "symbols_manager.c", "Failed to duplicate symbol_name");
-				symbolsManager->has_symbols_errors = FOUND;
-				return;
-			}
-
-			if (action_exists(actions, line[1])) {
-				addSymbol(macroManager, symbolsManager, symbol_name, location, NOT_FOUND, actions, registers);
-			}
-			else if (strcmp(line[1], ".string") == 0 || strcmp(line[1], ".data") == 0) {
-				addSymbol(macroManager, symbolsManager, symbol_name, location, FOUND, actions, registers);
-			}
+	else if (parsed->label != NO_ATOM) {
+		/* The label was interned when the line was built*/
+		const char* symbol_name = atom_name(&symbolsManager->atoms, parsed->label);
 
-			free(symbol_name);
+		if (parsed->type == ActionLine) {
+			addSymbol(symbolsManager, symbol_name, location, NOT_FOUND, registers);
+		}
+		else if (parsed->type == DataLine || parsed->type == StringLine) {
+			addSymbol(symbolsManager, symbol_name, location, FOUND, registers);
 		}
 	}
 }
@@ -430,16 +432,6 @@ void updateDataSymbolsLocation(const SymbolsManager* manager, int steps) {
 	}
 }
 
-int is_symbol_exists(const SymbolsManager* manager, const char* symbol_name) {
-	int i;
-	for (i = 0; i < manager->used; i++) {
-		if (strcmp(manager->array[i].symbol_name, symbol_name) == 0) {
-			return FOUND;
-		}
-	}
-	return NOT_FOUND; /* Indicate that the symbol was not found*/
-}
-
 /**
  * addReferenceSymbol -
  * Adds a reference symbol to the SymbolsManager.
@@ -451,33 +443,23 @@ int is_symbol_exists(const SymbolsManager* manager, const char* symbol_name) {
  */
 void addReferenceSymbol(SymbolsManager* manager, const char* name, int location, int type) {
 	ReferenceSymbol* new_ref_symbols;
+	Atom atom;
 	if (manager->ref_used == manager->ref_size) {
 		manager->ref_size *= 2;
-		new_ref_symbols = (ReferenceSymbol*)realloc(manager->ref_symbols, manager->ref_size * sizeof(ReferenceSymbol));
+		new_ref_symbols = (ReferenceSymbol*)resize_memory(manager->allocator, manager->ref_symbols, manager->ref_size * sizeof(ReferenceSymbol));
 		if (new_ref_symbols == NULL) {
 			log_error("addReferenceSymbol", 458, "symbols_manager.c", "Failed to reallocate memory for ReferenceSymbol array");
 			manager->has_symbols_errors = FOUND;
-			free(manager->ref_symbols);
-			free(manager->ent);
-			free(manager->ext);
-			free(manager->array);
-			free(manager);
 			return;
 		}
 		manager->ref_symbols = new_ref_symbols;
 	}
-	manager->ref_symbols[manager->ref_used].name = duplicate_string(name);
-	if (manager->ref_symbols[manager->ref_used].name == NULL) {
-		log_error("addReferenceSymbol", 471, "symbols_manager.c", "Failed to duplicate name");
-
-		manager->has_symbols_errors = FOUND;
-		free(manager->ref_symbols);
-		free(manager->ent);
-		free(manager->ext);
-		free(manager->array);
-		free(manager);
+	atom = internSymbolName(manager, name, strlen(name));
+	if (atom == NO_ATOM) {
+		log_error("addReferenceSymbol", 480, "symbols_manager.c", "Failed to intern name");
 		return;
 	}
+	manager->ref_symbols[manager->ref_used].name = atom_name(&manager->atoms, atom);
 	manager->ref_symbols[manager->ref_used].location = location;
 	manager->ref_symbols[manager->ref_used].type = type;
 	manager->ref_used++;
@@ -511,15 +493,15 @@ void printReferenceSymbols(const SymbolsManager* manager) {
  * @return `FOUND` if the symbol is found, `NOT_FOUND` if it is not found or if input is invalid.
  */
 int isRefExtSymbolExists(const SymbolsManager* manager, const char* symbol_name) {
-	int i;
+	Atom atom;
 	if (manager == NULL || symbol_name == NULL) {
 		return NOT_FOUND; /* Return 0 if the manager or symbol_name is NULL*/
 	}
 
-	for (i = 0; i < manager->ext_used; i++) {
-		if (strcmp(manager->ext[i], symbol_name) == 0) {
-			return FOUND; /* Return true if the symbol_name exists in the ext array*/
-		}
+	/* A name that was never interned was never declared*/
+	atom = find_atom(&manager->atoms, symbol_name, strlen(symbol_name));
+	if (atom != NO_ATOM && (manager->atom_index[atom].references & REFERENCE_EXTERN)) {
+		return FOUND; /* Return true if the symbol_name exists in the ext array*/
 	}
 
 	return NOT_FOUND; /* Return false if the symbol_name does not exist in the ext array*/
@@ -534,19 +516,18 @@ int isRefExtSymbolExists(const SymbolsManager* manager, const char* symbol_name)
  * @return `FOUND` if the symbol is found, `NOT_FOUND` if it is not found or if input is invalid.
  */
 int isRefEntSymbolExists(const SymbolsManager* manager, const char* symbol_name) {
-	int i;
-
+	Atom atom;
 	if (manager == NULL || symbol_name == NULL) {
 		return NOT_FOUND; /* Return 0 if the manager or symbol_name is NULL*/
 	}
 
-	for (i = 0; i < manager->ent_used; i++) {
-		if (strcmp(manager->ent[i], symbol_name) == 0) {
-			return FOUND; /* Return true if the symbol_name exists in the ext array*/
-		}
+	/* A name that was never interned was never declared*/
+	atom = find_atom(&manager->atoms, symbol_name, strlen(symbol_name));
+	if (atom != NO_ATOM && (manager->atom_index[atom].references & REFERENCE_ENTRY)) {
+		return FOUND; /* Return true if the symbol_name exists in the ent array*/
 	}
 
-	return NOT_FOUND; /* Return false if the symbol_name does not exist in the ext array*/
+	return NOT_FOUND; /* Return false if the symbol_name does not exist in the ent array*/
 }
 
 /**
@@ -556,17 +537,15 @@ int isRefEntSymbolExists(const SymbolsManager* manager, const char* symbol_name)
  * - It is not an existing action name.
  * - It is not a valid register name.
  *
- * @param manager The SymbolsManager instance (currently unused).
  * @param symbol_name The name of the symbol to validate.
- * @param actions The Action instance used to check for existing actions.
  * @return `FOUND` if the symbol name is valid, `NOT_FOUND` otherwise.
  */
-int is_valid_symbol_name(const SymbolsManager* manager, char* symbol_name, Action* actions, Registers* registers) {
+int is_valid_symbol_name(const char* symbol_name, Registers* registers) {
 	if (strlen(symbol_name) > MAX_SYMBOL_NAME_LENGTH) {
 		return NOT_FOUND;
 	}
 
-	if (action_exists(actions, symbol_name)) {
+	if (action_exists(symbol_name)) {
 		return NOT_FOUND;
 	}
 	if (is_valid_register(registers, symbol_name)) {
@@ -11,30 +11,56 @@
 #include "error_manager.h"
 #include "macro_manager.h"
 #include "operands.h"
+#include "memory_manager.h"
+#include "atom_manager.h"
+#include "line_builder.h"
+
+#define REFERENCE_EXTERN 1 /* The atom was declared by .extern*/
+#define REFERENCE_ENTRY 2  /* The atom was declared by .entry*/
+
 typedef struct {
-	char* symbol_name;
+	const char* symbol_name; /* Interned in the SymbolsManager's atoms*/
 	int symbol_location;
 	int is_data;
 } Symbols;
 
 
+/* What a name is in the file, indexed by the name's atom*/
+typedef struct {
+	int symbol;     /* Index in the symbols array, NOT_FOUND_SYMBOL if the name is not a symbol*/
+	int references; /* REFERENCE_EXTERN and REFERENCE_ENTRY flags*/
+} SymbolIndex;
+
+
+/* What a label operand refers to*/
+typedef enum SymbolKind {
+	UnknownSymbol,  /* Not declared in the file*/
+	LocalSymbol,    /* A symbol of the file*/
+	ExternalSymbol  /* Declared by .extern*/
+} SymbolKind;
+
+
 /* New structure for reference symbols*/
 typedef struct {
-	char* name;
+	const char* name;
 	int location;
 	int type; /* true for ext, false for ent*/
 } ReferenceSymbol;
 
 
 struct SymbolsManager {
+	Allocator* allocator; /* Owner of the symbols' memory*/
+	AtomTable atoms; /* One copy of every name of the file, the tables below are indexed by atom*/
+	SymbolIndex* atom_index; /* What each atom names, read in one access*/
+	int atom_size;
 	Symbols* array;
 	int has_symbols_errors;
 	int used;
 	int size;
-	char** ext;
+	const char** ext;
 	int ext_used;
 	int ext_size;
-	char** ent;
+	const char** ent;
 	int ent_used;
 	int ent_size;
 	ReferenceSymbol* ref_symbols;
@@ -56,27 +82,31 @@ void printReferenceSymbols(const SymbolsManager* manager);
 
 
 /* Function to create a SymbolsManager instance*/
-SymbolsManager* createSymbolsManager(void);
+SymbolsManager* createSymbolsManager(Allocator* allocator);
+
+/* Function to intern a name in the manager*/
+Atom internSymbolName(SymbolsManager* manager, const char* name, size_t length);
 
 /* Function to add a symbol to the manager*/
-void addSymbol(MacroManager* macroManager, SymbolsManager* manager, char* symbol_name, int symbol_location, int is_data, Action* actions, Registers* registers);
+void addSymbol(SymbolsManager* manager, const char* symbol_name, int symbol_location, int is_data, Registers* registers);
+
+/* Function to check, once all the macros are known, that no symbol is a macro name*/
+void checkSymbolsMacroNames(MacroManager* macroManager, SymbolsManager* manager);
 
 /* Function to print all symbols*/
 void printSymbols(const SymbolsManager* manager);
 
 /* Function to get the location of a symbol by its name*/
 int getSymbolLocation(const SymbolsManager* manager, const char* symbol_name);
+SymbolKind resolveSymbol(const SymbolsManager* manager, Atom atom, int* location);
 int isRefExtSymbolExists(const SymbolsManager* manager, const char* symbol_name);
 int isRefEntSymbolExists(const SymbolsManager* manager, const char* symbol_name);
 
-/* Function to destroy a SymbolsManager instance and free resources*/
-void destroySymbolsManager(SymbolsManager* manager);
-
 /* Function to add a value to ext or ent*/
 void addExtEnt(SymbolsManager* manager, const char* value, int is_ext);
 
 /* Function to update the symbols table*/
-void updateSymbolsTable(MacroManager* macroManager, SymbolsManager* manager, char** line, int location, Action* actions, Registers* registers);
+void updateSymbolsTable(SymbolsManager* manager, const ParsedLine* parsed, int location, Registers* registers);
 
 /* Function to check if an action exists*/
 void printExt(const SymbolsManager* manager);
@@ -91,8 +121,6 @@ int isReferencePattern(const char* word);
 
 void updateDataSymbolsLocation(const SymbolsManager* manager, int steps);
 
-int is_symbol_exists(const SymbolsManager* manager, const char* symbol_name);
-
-int is_valid_symbol_name(const SymbolsManager* manager, char* symbol_name, Action* actions, Registers* registers);
+int is_valid_symbol_name(const char* symbol_name, Registers* registers);
 #endif /* SYMBOLS_MANAGER_H*/
 
@@ -0,0 +1,82 @@
+#include "trace_manager.h"
+
+/**
+ * print_trace_event -
+ * Prints a complete event of the trace: a span of time on a thread.
+ *
+ * @param file The trace file.
+ * @param name The name of the span.
+ * @param category "file" for a whole file, "phase" for a phase of a file.
+ * @param file_name The file the span belongs to.
+ * @param thread The id of the thread the span ran on.
+ * @param start stats_time when the span started.
+ * @param seconds How long the span took.
+ * @param origin stats_time of the start of the run, the trace's time zero.
+ */
+static void print_trace_event(FILE* file, const char* name, const char* category, const char* file_name, int thread, double start, double seconds, double origin) {
+	fprintf(file, ",\n{\"name\": ");
+	print_json_string(file, name);
+	fprintf(file, ", \"cat\": \"%s\", \"ph\": \"X\", \"ts\": %.3f, \"dur\": %.3f, \"pid\": %d, \"tid\": %d, \"args\": {\"file\": ",
+		category, (start - origin) * 1e6, seconds * 1e6, TRACE_PROCESS_ID, thread);
+	print_json_string(file, file_name);
+	fprintf(file, "}}");
+}
+
+/**
+ * write_trace_file -
+ * Writes when every file and every phase of a file ran, and on which thread, as a Chrome
+ * trace-event JSON file (it opens in chrome://tracing or Perfetto).
+ * A worker of the jobs is thread TRACE_THREADS_PER_WORKER * worker, the thread that expands
+ * the macros for it is the next one.
+ *
+ * @param file_path The path of the trace file.
+ * @param jobs The jobs, once they all ran.
+ * @param job_count The number of jobs.
+ * @param origin stats_time of the start of the run, the trace's time zero.
+ * @return FOUND if the trace was written, NOT_FOUND otherwise.
+ */
+int write_trace_file(const char* file_path, const Job* jobs, int job_count, double origin) {
+	char threads[TRACE_THREADS_PER_WORKER * MAX_JOB_THREADS];
+	int i, phase, thread;
+	const Job* job;
+	FILE* file = fopen(file_path, "w");
+
+	if (file == NULL) {
+		file_error("write_trace_file", 45, "trace_manager.c", "Failed to open file", file_path);
+		return NOT_FOUND;
+	}
+
+	memset(threads, 0, sizeof(threads));
+	fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+	fprintf(file, "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": %d, \"args\": {\"name\": \"assembler\"}}", TRACE_PROCESS_ID);
+
+	for (i = 0; i < job_count; i++) {
+		job = &jobs[i];
+		thread = TRACE_THREADS_PER_WORKER * job->thread;
+		threads[thread] = FOUND;
+		print_trace_event(file, job->file_name, "file", job->file_name, thread, job->start, job->seconds, origin);
+		for (phase = 0; phase < STATS_PHASE_COUNT; phase++) {
+			if (job->stats.start[phase] < 0) {
+				continue;
+			}
+			if (phase == InputPhase && job->stats.input_thread) {
+				threads[thread + 1] = FOUND;
+				print_trace_event(file, phase_name(phase), "phase", job->file_name, thread + 1, job->stats.start[phase], job->stats.seconds[phase], origin);
+			}
+			else {
+				print_trace_event(file, phase_name(phase), "phase", job->file_name, thread, job->stats.start[phase], job->stats.seconds[phase], origin);
+			}
+		}
+	}
+
+	/* Name the threads that ran something*/
+	for (thread = 0; thread < TRACE_THREADS_PER_WORKER * MAX_JOB_THREADS; thread++) {
+		if (threads[thread]) {
+			fprintf(file, ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": %d, \"args\": {\"name\": \"worker %d%s\"}}",
+				TRACE_PROCESS_ID, thread, thread / TRACE_THREADS_PER_WORKER, thread % TRACE_THREADS_PER_WORKER ? " macros" : "");
+		}
+	}
+	fprintf(file, "\n]}\n");
+	fclose(file);
+	return FOUND;
+}
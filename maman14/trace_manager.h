@@ -0,0 +1,17 @@
+#ifndef TRACE_MANAGER_H
+#define TRACE_MANAGER_H
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#include "constants.h"
+#include "error_manager.h"
+#include "stats_manager.h"
+#include "job_manager.h"
+
+#define TRACE_PROCESS_ID 1
+#define TRACE_THREADS_PER_WORKER 2 /* A worker and the thread that expands the macros of its file*/
+
+int write_trace_file(const char* file_path, const Job* jobs, int job_count, double origin);
+
+#endif /* TRACE_MANAGER_H*/